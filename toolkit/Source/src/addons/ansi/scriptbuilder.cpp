@@ -16,11 +16,14 @@ BEGIN_AS_NAMESPACE
 // Helper functions
 static const char *GetCurrentDir(char *buf, size_t size);
 
+const asQWORD CScriptBuilder::HASH_OFFSET_BASIS = 14695981039346656037ULL;
+
 CScriptBuilder::CScriptBuilder(const ETHResourceProviderPtr& provider) :
 	m_provider(provider)
 {
 	engine = 0;
 	module = 0;
+	sourceHash = HASH_OFFSET_BASIS;
 
 	includeCallback = 0;
 	callbackParam   = 0;
@@ -90,6 +93,7 @@ void CScriptBuilder::DefineWord(const char *word)
 void CScriptBuilder::ClearAll()
 {
 	includedScripts.clear();
+	sourceHash = HASH_OFFSET_BASIS;
 
 #if AS_PROCESS_METADATA == 1	
 	foundDeclarations.clear();
@@ -292,6 +296,11 @@ int CScriptBuilder::ProcessScriptSection(const char *script, const char *section
 			pos = SkipStatement(pos);
 	}
 
+	// Keep track of what is being compiled
+	const string hashedSectionName = sectionname;
+	sourceHash = HashBytes(hashedSectionName.c_str(), hashedSectionName.size() + 1, sourceHash);
+	sourceHash = HashBytes(modifiedScript.c_str(), modifiedScript.size(), sourceHash);
+
 	// Build the actual script
 	engine->SetEngineProperty(asEP_COPY_SCRIPT_SECTIONS, true);
 	module->AddScriptSection(sectionname, modifiedScript.c_str(), modifiedScript.size());
@@ -341,6 +350,25 @@ int CScriptBuilder::ProcessScriptSection(const char *script, const char *section
 	return 0;
 }
 
+asQWORD CScriptBuilder::GetSourceHash() const
+{
+	asQWORD hash = sourceHash;
+	for( set<string>::const_iterator it = definedWords.begin(); it != definedWords.end(); ++it )
+		hash = HashBytes(it->c_str(), it->size() + 1, hash);
+	return hash;
+}
+
+asQWORD CScriptBuilder::HashBytes(const void *data, size_t size, asQWORD hash)
+{
+	const unsigned char *bytes = (const unsigned char*)data;
+	for( size_t n = 0; n < size; n++ )
+	{
+		hash ^= bytes[n];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
 int CScriptBuilder::Build()
 {
 	int r = module->Build();
@@ -76,6 +76,14 @@ public:
 	// Add a pre-processor define for conditional compilation
 	void DefineWord(const char *word);
 
+	// Hash of every section added so far, after pre-processing, and of the
+	// defined words. Can be used to tell whether a cached byte code is still valid
+	asQWORD GetSourceHash() const;
+
+	// FNV-1a hash of size bytes, continuing from hash
+	static asQWORD HashBytes(const void *data, size_t size, asQWORD hash = HASH_OFFSET_BASIS);
+	static const asQWORD HASH_OFFSET_BASIS;
+
 #if AS_PROCESS_METADATA == 1
 	// Get metadata declared for class types and interfaces
 	const char *GetMetadataStringForType(int typeId);
@@ -134,6 +142,8 @@ protected:
 	std::set<std::string>      includedScripts;
 
 	std::set<std::string>      definedWords;
+
+	asQWORD                    sourceHash;
 };
 
 END_AS_NAMESPACE
@@ -163,7 +163,7 @@ void RegisterScriptMath2D_Native(asIScriptEngine *engine)
 	int r;
 
 	// Register the type
-	r = engine->RegisterObjectType("vector2", sizeof(Vector2), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_CA); assert( r >= 0 );
+	r = engine->RegisterObjectType("vector2", sizeof(Vector2), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_CAK); assert( r >= 0 );
 
 	// Register the object properties
 	r = engine->RegisterObjectProperty("vector2", "float x", offsetof(PODVector2, x)); assert( r >= 0 );
@@ -196,7 +196,7 @@ void RegisterScriptMath2D_Generic(asIScriptEngine *engine)
 	int r;
 
 	// Register the type
-	r = engine->RegisterObjectType("vector2", sizeof(Vector2), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_CA); assert( r >= 0 );
+	r = engine->RegisterObjectType("vector2", sizeof(Vector2), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_CAK); assert( r >= 0 );
 
 	// Register the object properties
 	r = engine->RegisterObjectProperty("vector2", "float x", offsetof(PODVector2, x)); assert( r >= 0 );
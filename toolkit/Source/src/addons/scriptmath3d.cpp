@@ -172,7 +172,7 @@ void RegisterScriptMath3D_Native(asIScriptEngine *engine)
 	int r;
 
 	// Register the type
-	r = engine->RegisterObjectType("vector3", sizeof(Vector3), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_CA); assert( r >= 0 );
+	r = engine->RegisterObjectType("vector3", sizeof(Vector3), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_CAK); assert( r >= 0 );
 
 	// Register the object properties
 	r = engine->RegisterObjectProperty("vector3", "float x", offsetof(PODVector3, x)); assert( r >= 0 );
@@ -207,7 +207,7 @@ void RegisterScriptMath3D_Generic(asIScriptEngine *engine)
 	int r;
 
 	// Register the type
-	r = engine->RegisterObjectType("vector3", sizeof(Vector3), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_CA); assert( r >= 0 );
+	r = engine->RegisterObjectType("vector3", sizeof(Vector3), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_CAK); assert( r >= 0 );
 
 	// Register the object properties
 	r = engine->RegisterObjectProperty("vector3", "float x", offsetof(PODVector3, x)); assert( r >= 0 );
@@ -55,147 +55,99 @@ typedef asQWORD ( *funcptr_t )( void );
 #define CALLSTACK_MULTIPLIER      2
 #define X64_CALLSTACK_SIZE        ( X64_MAX_ARGS + MAX_CALL_SSE_REGISTERS + 3 )
 
+// Registers and arguments exchanged with X64_CallFunction(). The whole call is
+// made from a single asm block, so that the optimizer can't reuse the argument
+// and return registers in between the steps
+struct asSX64CallData
+{
+	const asDWORD *args;
+	asQWORD        stackArgCount;
+	void          *func;
+	asQWORD        retRAX;
+	asQWORD        retRDX;
+	asQWORD        retXMM0;
+};
+
 // Note to self: Always remember to inform the used registers on the clobber line, 
 // so that the gcc optimizer doesn't try to use them for other things
 
-#define PUSH_LONG( val )                         \
-	__asm__ __volatile__ (                       \
-		"movq   %0, %%rax\n"                     \
-		"pushq  %%rax"                           \
-		:                                        \
-		: "m" ( val )                            \
-		: "%rax"                                 \
-	)
-
-// While movq really should be used to move from general 
-// purpose register to xmm register, this is isn't accepted
-// by older GNUC versions, where movd should be used instead.
-// Reference: http://gcc.gnu.org/bugzilla/show_bug.cgi?id=43215
-#if (__GNUC__ < 4) || (__GNUC__ == 4 && __GNUC_MINOR__ <= 2)
-#define POP_LONG( reg )                          \
-	__asm__ __volatile__ (                       \
-		"popq     %%rax\n"                       \
-		"movq     %%rax, %" reg                  \
-		:                                        \
-		:                                        \
-		: "%rax", reg                            \
-	)
-
-#define POP_LONG_XMM( reg )                      \
-	__asm__ __volatile__ (                       \
-		"popq     %%rax\n"                       \
-		"movd     %%rax, %" reg                  \
-		:                                        \
-		:                                        \
-		: "%rax", reg                            \
-	)
-#else
-#define POP_LONG( reg )                          \
-	__asm__ __volatile__ (                       \
-		"popq     %%rax\n"                       \
-		"movq     %%rax, %" reg                  \
-		:                                        \
-		:                                        \
-		: "%rax", reg                            \
-	)
-
-#define POP_LONG_XMM( reg ) POP_LONG( reg )
-#endif
-
-#define ASM_GET_REG( name, dest )                \
-	__asm__ __volatile__ (                       \
-		"movq %" name ", %0\n"                   \
-		:                                        \
-		: "m" ( dest )                           \
-		: name                                   \
-	)
-
-
-static asDWORD GetReturnedFloat()
+static void __attribute__ ((noinline)) X64_CallFunction( const asDWORD* pArgs, const asBYTE *pArgsType, void *func, asSX64CallData &data )
 {
-	float   retval = 0.0f;
-	asDWORD ret    = 0;
+	int i = 0;
 
-	__asm__ __volatile__ (
-		"lea      %0, %%rax\n"
-		"movss    %%xmm0, (%%rax)"
-		: /* no output */
-		: "m" (retval)
-		: "%rax"
-	);
+	data.args          = pArgs;
+	data.stackArgCount = 0;
+	data.func          = func;
 
-	// We need to avoid implicit conversions from float to unsigned - we need
-	// a bit-wise-correct-and-complete copy of the value 
-	memcpy( &ret, &retval, sizeof( ret ) );
-
-	return ( asDWORD )ret;
-}
-
-static asQWORD GetReturnedDouble()
-{
-	double  retval = 0.0f;
-	asQWORD ret    = 0;
-
-	__asm__ __volatile__ (
-		"lea     %0, %%rax\n"
-		"movlpd  %%xmm0, (%%rax)"
-		: /* no optput */
-		: "m" (retval)
-		: "%rax"
-	);
-
-	// We need to avoid implicit conversions from double to unsigned long long - we need
-	// a bit-wise-correct-and-complete copy of the value 
-	memcpy( &ret, &retval, sizeof( ret ) );
-
-	return ret;
-}
-
-// Note to self: If there is any trouble with a function when it is optimized, gcc supports
-// turning off optimization for individual functions by adding the following to the declaration:
-// __attribute__ ((optimize(0)))
-
-static asQWORD __attribute__ ((noinline)) X64_CallFunction( const asDWORD* pArgs, const asBYTE *pArgsType, void *func )
-{
-	asQWORD retval      = 0;
-	asQWORD ( *call )() = (asQWORD (*)())func;
-	int     i           = 0;
-
-	/* push the stack parameters */
+	// count the parameters that go on the stack
 	for ( i = MAX_CALL_INT_REGISTERS + MAX_CALL_SSE_REGISTERS; pArgsType[i] != x64ENDARG && ( i < X64_MAX_ARGS + MAX_CALL_SSE_REGISTERS + 3 ); i++ ) {
-		PUSH_LONG( pArgs[i * CALLSTACK_MULTIPLIER] );
+		data.stackArgCount++;
 	}
 
-	/* push integer parameters */
-	for ( i = 0; i < MAX_CALL_INT_REGISTERS; i++ ) {
-		PUSH_LONG( pArgs[i * CALLSTACK_MULTIPLIER] );
-	}
-
-	/* push floating point parameters */
-	for ( i = MAX_CALL_INT_REGISTERS; i < MAX_CALL_INT_REGISTERS + MAX_CALL_SSE_REGISTERS; i++ ) {
-		PUSH_LONG( pArgs[i * CALLSTACK_MULTIPLIER] );
-	}
+	asSX64CallData *pData = &data;
 
-	/* now pop the registers in reverse order and make the call */
-	POP_LONG_XMM( "%xmm7" );
-	POP_LONG_XMM( "%xmm6" );
-	POP_LONG_XMM( "%xmm5" );
-	POP_LONG_XMM( "%xmm4" );
-	POP_LONG_XMM( "%xmm3" );
-	POP_LONG_XMM( "%xmm2" );
-	POP_LONG_XMM( "%xmm1" );
-	POP_LONG_XMM( "%xmm0" );
-
-	POP_LONG( "%r9" );
-	POP_LONG( "%r8" );
-	POP_LONG( "%rcx" );
-	POP_LONG( "%rdx" );
-	POP_LONG( "%rsi" );
-	POP_LONG( "%rdi" );
-
-	// call the function with the arguments
-	retval = call();
-	return retval;
+	__asm__ __volatile__ (
+		// keep the data pointer and the original stack in callee saved registers
+		"movq   %%rdi, %%r13\n"
+		"movq   %%rsp, %%r12\n"
+		"movq   0(%%r13), %%r10\n"
+		"movq   8(%%r13), %%rcx\n"
+
+		// skip the red zone and reserve 16 byte aligned room for the stack parameters
+		"subq   $128, %%rsp\n"
+		"leaq   0(,%%rcx,8), %%rax\n"
+		"subq   %%rax, %%rsp\n"
+		"andq   $-16, %%rsp\n"
+
+		// the stack parameters are stored in reverse order after the register ones
+		"xorq   %%rax, %%rax\n"
+		"1:\n"
+		"cmpq   %%rcx, %%rax\n"
+		"jge    2f\n"
+		"movq   %%rcx, %%rdx\n"
+		"subq   %%rax, %%rdx\n"
+		"movq   104(%%r10,%%rdx,8), %%rdx\n"
+		"movq   %%rdx, (%%rsp,%%rax,8)\n"
+		"incq   %%rax\n"
+		"jmp    1b\n"
+		"2:\n"
+
+		// floating point parameters
+		"movsd  48(%%r10), %%xmm0\n"
+		"movsd  56(%%r10), %%xmm1\n"
+		"movsd  64(%%r10), %%xmm2\n"
+		"movsd  72(%%r10), %%xmm3\n"
+		"movsd  80(%%r10), %%xmm4\n"
+		"movsd  88(%%r10), %%xmm5\n"
+		"movsd  96(%%r10), %%xmm6\n"
+		"movsd  104(%%r10), %%xmm7\n"
+
+		// integer parameters
+		"movq   0(%%r10), %%rdi\n"
+		"movq   8(%%r10), %%rsi\n"
+		"movq   16(%%r10), %%rdx\n"
+		"movq   24(%%r10), %%rcx\n"
+		"movq   32(%%r10), %%r8\n"
+		"movq   40(%%r10), %%r9\n"
+
+		// call the function with the arguments. %al holds an upper bound of the
+		// number of SSE registers used, in case the function takes variable arguments
+		"movq   16(%%r13), %%r11\n"
+		"movl   $8, %%eax\n"
+		"call   *%%r11\n"
+
+		// restore the stack and store every register a value may be returned in
+		"movq   %%r12, %%rsp\n"
+		"movq   %%rax, 24(%%r13)\n"
+		"movq   %%rdx, 32(%%r13)\n"
+		"movsd  %%xmm0, 40(%%r13)\n"
+		: "+D" ( pData )
+		:
+		: "%rax", "%rcx", "%rdx", "%rsi", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13",
+		  "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+		  "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15",
+		  "memory", "cc"
+	);
 }
 
 // returns true if the given parameter is a 'variable argument'
@@ -506,18 +458,23 @@ asQWORD CallSystemFunctionNative(asCContext *context, asCScriptFunction *descr,
 		}
 	}
 
+	asSX64CallData callData;
 	context->isCallingSystemFunction = true;
-	retQW = X64_CallFunction( tempBuff, tempType, ( asDWORD * )func );
-	ASM_GET_REG( "%rdx", retQW2 );
+	X64_CallFunction( tempBuff, tempType, func, callData );
 	context->isCallingSystemFunction = false;
 
 	// If the return is a float value we need to get the value from the FP register
 	if( sysFunc->hostReturnFloat )
 	{
 		if( sysFunc->hostReturnSize == 1 )
-			*(asDWORD*)&retQW = GetReturnedFloat();
+			retQW = callData.retXMM0 & 0xFFFFFFFF;
 		else
-			retQW = GetReturnedDouble();
+			retQW = callData.retXMM0;
+	}
+	else
+	{
+		retQW  = callData.retRAX;
+		retQW2 = callData.retRDX;
 	}
 
 	return retQW;
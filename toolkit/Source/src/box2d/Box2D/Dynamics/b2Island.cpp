@@ -26,6 +26,7 @@
 #include <Box2D/Dynamics/Joints/b2Joint.h>
 #include <Box2D/Common/b2StackAllocator.h>
 #include <Box2D/Common/b2Timer.h>
+#include <algorithm>
 
 /*
 Position Correction Notes
@@ -150,7 +151,8 @@ b2Island::b2Island(
 	int32 contactCapacity,
 	int32 jointCapacity,
 	b2StackAllocator* allocator,
-	b2ContactListener* listener)
+	b2ContactListener* listener,
+	bool concurrent)
 {
 	m_bodyCapacity = bodyCapacity;
 	m_contactCapacity = contactCapacity;
@@ -168,11 +170,24 @@ b2Island::b2Island(
 
 	m_velocities = (b2Velocity*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Velocity));
 	m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
+
+	m_concurrent = concurrent;
+	m_statics = NULL;
+	m_staticCount = 0;
+	m_staticsSorted = true;
+	if (m_concurrent)
+	{
+		m_statics = (b2IslandStaticBody*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2IslandStaticBody));
+	}
 }
 
 b2Island::~b2Island()
 {
 	// Warning: the order should reverse the constructor order.
+	if (m_statics)
+	{
+		m_allocator->Free(m_statics);
+	}
 	m_allocator->Free(m_positions);
 	m_allocator->Free(m_velocities);
 	m_allocator->Free(m_joints);
@@ -180,12 +195,50 @@ b2Island::~b2Island()
 	m_allocator->Free(m_bodies);
 }
 
+static bool b2StaticBodyLessThan(const b2IslandStaticBody& a, const b2IslandStaticBody& b)
+{
+	return a.body < b.body;
+}
+
+void b2Island::SortStatics()
+{
+	if (m_staticsSorted == false)
+	{
+		std::sort(m_statics, m_statics + m_staticCount, b2StaticBodyLessThan);
+		m_staticsSorted = true;
+	}
+}
+
+int32 b2Island::GetIndex(const b2Body* body) const
+{
+	if (m_concurrent == false || body->m_type != b2_staticBody)
+	{
+		return body->m_islandIndex;
+	}
+
+	b2Assert(m_staticsSorted);
+	b2IslandStaticBody key;
+	key.body = body;
+	key.index = 0;
+	const b2IslandStaticBody* end = m_statics + m_staticCount;
+	const b2IslandStaticBody* found = std::lower_bound((const b2IslandStaticBody*)m_statics, end, key, b2StaticBodyLessThan);
+	if (found != end && found->body == body)
+	{
+		return found->index;
+	}
+
+	// Not part of this island (e.g. the ground of a gear joint).
+	return body->m_islandIndex;
+}
+
 void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
 {
 	b2Timer timer;
 
 	float32 h = step.dt;
 
+	SortStatics();
+
 	// Integrate velocities and apply damping. Initialize the body state.
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
@@ -196,9 +249,13 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		b2Vec2 v = b->m_linearVelocity;
 		float32 w = b->m_angularVelocity;
 
-		// Store positions for continuous collision.
-		b->m_sweep.c0 = b->m_sweep.c;
-		b->m_sweep.a0 = b->m_sweep.a;
+		// Store positions for continuous collision. Static bodies never move
+		// and may be shared with other concurrent islands.
+		if (m_concurrent == false || b->m_type != b2_staticBody)
+		{
+			b->m_sweep.c0 = b->m_sweep.c;
+			b->m_sweep.a0 = b->m_sweep.a;
+		}
 
 		if (b->m_type == b2_dynamicBody)
 		{
@@ -230,6 +287,7 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	solverData.step = step;
 	solverData.positions = m_positions;
 	solverData.velocities = m_velocities;
+	solverData.island = this;
 
 	// Initialize velocity constraints.
 	b2ContactSolverDef contactSolverDef;
@@ -239,6 +297,7 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
 	contactSolverDef.allocator = m_allocator;
+	contactSolverDef.island = this;
 
 	b2ContactSolver contactSolver(&contactSolverDef);
 	contactSolver.InitializeVelocityConstraints();
@@ -330,6 +389,10 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+		if (m_concurrent && body->m_type == b2_staticBody)
+		{
+			continue;
+		}
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -375,6 +438,10 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
+				if (m_concurrent && b->m_type == b2_staticBody)
+				{
+					continue;
+				}
 				b->SetAwake(false);
 			}
 		}
@@ -386,6 +453,8 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 	b2Assert(toiIndexA < m_bodyCount);
 	b2Assert(toiIndexB < m_bodyCount);
 
+	SortStatics();
+
 	// Initialize the body state.
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
@@ -403,6 +472,7 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 	contactSolverDef.step = subStep;
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
+	contactSolverDef.island = this;
 	b2ContactSolver contactSolver(&contactSolverDef);
 
 	// Solve position constraints.
@@ -537,3 +607,27 @@ void b2Island::Report(const b2ContactVelocityConstraint* constraints)
 		m_listener->PostSolve(c, &impulse);
 	}
 }
+
+void b2Island::ReportStoredImpulses(b2ContactListener* listener, b2Contact** contacts, int32 count)
+{
+	if (listener == NULL)
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		b2Contact* c = contacts[i];
+		const b2Manifold* manifold = c->GetManifold();
+
+		b2ContactImpulse impulse;
+		impulse.count = manifold->pointCount;
+		for (int32 j = 0; j < manifold->pointCount; ++j)
+		{
+			impulse.normalImpulses[j] = manifold->points[j].normalImpulse;
+			impulse.tangentImpulses[j] = manifold->points[j].tangentImpulse;
+		}
+
+		listener->PostSolve(c, &impulse);
+	}
+}
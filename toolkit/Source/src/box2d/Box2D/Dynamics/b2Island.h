@@ -30,12 +30,21 @@ class b2ContactListener;
 struct b2ContactVelocityConstraint;
 struct b2Profile;
 
+/// Solver slot of a static body inside a concurrent island.
+struct b2IslandStaticBody
+{
+	const b2Body* body;
+	int32 index;
+};
+
 /// This is an internal class.
 class b2Island
 {
 public:
+	/// A concurrent island may be solved while other islands sharing its static bodies are
+	/// being solved too, so it never writes to static bodies.
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
-			b2StackAllocator* allocator, b2ContactListener* listener);
+			b2StackAllocator* allocator, b2ContactListener* listener, bool concurrent = false);
 	~b2Island();
 
 	void Clear()
@@ -43,6 +52,8 @@ public:
 		m_bodyCount = 0;
 		m_contactCount = 0;
 		m_jointCount = 0;
+		m_staticCount = 0;
+		m_staticsSorted = true;
 	}
 
 	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
@@ -52,11 +63,25 @@ public:
 	void Add(b2Body* body)
 	{
 		b2Assert(m_bodyCount < m_bodyCapacity);
-		body->m_islandIndex = m_bodyCount;
+		if (m_concurrent && body->m_type == b2_staticBody)
+		{
+			// static bodies may belong to several islands, keep their slot here
+			m_statics[m_staticCount].body = body;
+			m_statics[m_staticCount].index = m_bodyCount;
+			++m_staticCount;
+			m_staticsSorted = false;
+		}
+		else
+		{
+			body->m_islandIndex = m_bodyCount;
+		}
 		m_bodies[m_bodyCount] = body;
 		++m_bodyCount;
 	}
 
+	/// Returns the solver slot of a body added to this island.
+	int32 GetIndex(const b2Body* body) const;
+
 	void Add(b2Contact* contact)
 	{
 		b2Assert(m_contactCount < m_contactCapacity);
@@ -71,6 +96,10 @@ public:
 
 	void Report(const b2ContactVelocityConstraint* constraints);
 
+	/// Reports the impulses stored in the contact manifolds by a previous Solve. Used for
+	/// concurrent islands, whose listener can only be called once all of them are done.
+	static void ReportStoredImpulses(b2ContactListener* listener, b2Contact** contacts, int32 count);
+
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
@@ -88,6 +117,14 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	bool m_concurrent;
+	b2IslandStaticBody* m_statics;
+	int32 m_staticCount;
+	bool m_staticsSorted;
+
+private:
+	void SortStatics();
 };
 
 #endif
@@ -61,6 +61,10 @@ b2World::b2World(const b2Vec2& gravity, bool doSleep)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+
+	m_taskExecutor = NULL;
+	m_solverAllocators = NULL;
+	m_solverAllocatorCount = 0;
 }
 
 b2World::~b2World()
@@ -82,8 +86,92 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	DestroySolverAllocators();
+}
+
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	m_taskExecutor = executor;
+
+	// The allocators are created on demand by the next concurrent step
+	DestroySolverAllocators();
 }
 
+void b2World::DestroySolverAllocators()
+{
+	for (int32 i = 0; i < m_solverAllocatorCount; ++i)
+	{
+		m_solverAllocators[i]->~b2StackAllocator();
+		b2Free(m_solverAllocators[i]);
+	}
+	if (m_solverAllocators)
+	{
+		b2Free(m_solverAllocators);
+	}
+	m_solverAllocators = NULL;
+	m_solverAllocatorCount = 0;
+}
+
+/// Where an island's bodies, contacts and joints are found in the lists built by b2World::Solve.
+struct b2IslandRange
+{
+	int32 bodyStart, bodyCount;
+	int32 contactStart, contactCount;
+	int32 jointStart, jointCount;
+	int32 thread;
+};
+
+/// Solves, in order, the islands assigned to one thread.
+class b2IslandSolverTask : public b2Task
+{
+public:
+	void Execute()
+	{
+		memset(&profile, 0, sizeof(b2Profile));
+		for (int32 i = 0; i < islandCount; ++i)
+		{
+			const b2IslandRange& range = islands[i];
+			if (range.thread != thread)
+			{
+				continue;
+			}
+
+			b2Island island(range.bodyCount, range.contactCount, range.jointCount, allocator, NULL, true);
+			for (int32 j = 0; j < range.bodyCount; ++j)
+			{
+				island.Add(bodies[range.bodyStart + j]);
+			}
+			for (int32 j = 0; j < range.contactCount; ++j)
+			{
+				island.Add(contacts[range.contactStart + j]);
+			}
+			for (int32 j = 0; j < range.jointCount; ++j)
+			{
+				island.Add(joints[range.jointStart + j]);
+			}
+
+			b2Profile islandProfile;
+			island.Solve(&islandProfile, *step, gravity, allowSleep);
+			profile.solveInit += islandProfile.solveInit;
+			profile.solveVelocity += islandProfile.solveVelocity;
+			profile.solvePosition += islandProfile.solvePosition;
+		}
+	}
+
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+	const b2IslandRange* islands;
+	int32 islandCount;
+	b2Body** bodies;
+	b2Contact** contacts;
+	b2Joint** joints;
+	int32 thread;
+	b2StackAllocator* allocator;
+	b2Profile profile;
+};
+
 void b2World::SetDestructionListener(b2DestructionListener* listener)
 {
 	m_destructionListener = listener;
@@ -395,6 +483,23 @@ void b2World::Solve(const b2TimeStep& step)
 	// Build and simulate all awake islands.
 	int32 stackSize = m_bodyCount;
 	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+
+	// Islands that will be solved concurrently are only gathered here. Static bodies
+	// may show up in many islands, once per contact or joint at most.
+	int32 threadCount = m_taskExecutor ? m_taskExecutor->GetThreadCount() : 1;
+	b2IslandRange* islands = NULL;
+	b2Body** islandBodies = NULL;
+	b2Contact** islandContacts = NULL;
+	b2Joint** islandJoints = NULL;
+	int32 islandCount = 0, islandBodyCount = 0, islandContactCount = 0, islandJointCount = 0;
+	if (threadCount > 1)
+	{
+		const int32 contactCount = m_contactManager.m_contactCount;
+		islands = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+		islandBodies = (b2Body**)m_stackAllocator.Allocate((m_bodyCount + contactCount + m_jointCount) * sizeof(b2Body*));
+		islandContacts = (b2Contact**)m_stackAllocator.Allocate(contactCount * sizeof(b2Contact*));
+		islandJoints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+	}
 	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
 	{
 		if (seed->m_flags & b2Body::e_islandFlag)
@@ -509,11 +614,31 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
-		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
+		if (islands)
+		{
+			b2IslandRange* range = islands + islandCount++;
+			range->bodyStart = islandBodyCount;
+			range->bodyCount = island.m_bodyCount;
+			range->contactStart = islandContactCount;
+			range->contactCount = island.m_contactCount;
+			range->jointStart = islandJointCount;
+			range->jointCount = island.m_jointCount;
+			range->thread = 0;
+			memcpy(islandBodies + islandBodyCount, island.m_bodies, island.m_bodyCount * sizeof(b2Body*));
+			memcpy(islandContacts + islandContactCount, island.m_contacts, island.m_contactCount * sizeof(b2Contact*));
+			memcpy(islandJoints + islandJointCount, island.m_joints, island.m_jointCount * sizeof(b2Joint*));
+			islandBodyCount += island.m_bodyCount;
+			islandContactCount += island.m_contactCount;
+			islandJointCount += island.m_jointCount;
+		}
+		else
+		{
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+			m_profile.solveInit += profile.solveInit;
+			m_profile.solveVelocity += profile.solveVelocity;
+			m_profile.solvePosition += profile.solvePosition;
+		}
 
 		// Post solve cleanup.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
@@ -527,6 +652,15 @@ void b2World::Solve(const b2TimeStep& step)
 		}
 	}
 
+	if (islands)
+	{
+		SolveIslandsConcurrently(step, islands, islandCount, islandBodies, islandContacts, islandJoints, threadCount);
+		m_stackAllocator.Free(islandJoints);
+		m_stackAllocator.Free(islandContacts);
+		m_stackAllocator.Free(islandBodies);
+		m_stackAllocator.Free(islands);
+	}
+
 	m_stackAllocator.Free(stack);
 
 	{
@@ -555,6 +689,95 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 }
 
+void b2World::SolveIslandsConcurrently(const b2TimeStep& step, b2IslandRange* islands, int32 islandCount,
+	b2Body** bodies, b2Contact** contacts, b2Joint** joints, int32 threadCount)
+{
+	int32 taskCount = b2Min(threadCount, islandCount);
+	if (taskCount == 0)
+	{
+		return;
+	}
+
+	if (m_solverAllocatorCount < taskCount)
+	{
+		DestroySolverAllocators();
+		m_solverAllocators = (b2StackAllocator**)b2Alloc(threadCount * sizeof(b2StackAllocator*));
+		for (int32 i = 0; i < threadCount; ++i)
+		{
+			void* mem = b2Alloc(sizeof(b2StackAllocator));
+			m_solverAllocators[i] = new (mem) b2StackAllocator;
+		}
+		m_solverAllocatorCount = threadCount;
+	}
+
+	// Hand each island to the least loaded thread. This only depends on the island
+	// order, so a given scene is always split the same way.
+	int32* loads = (int32*)m_stackAllocator.Allocate(taskCount * sizeof(int32));
+	for (int32 i = 0; i < taskCount; ++i)
+	{
+		loads[i] = 0;
+	}
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		int32 thread = 0;
+		for (int32 j = 1; j < taskCount; ++j)
+		{
+			if (loads[j] < loads[thread])
+			{
+				thread = j;
+			}
+		}
+		islands[i].thread = thread;
+		loads[thread] += islands[i].bodyCount + islands[i].contactCount + islands[i].jointCount;
+	}
+
+	b2IslandSolverTask* tasks = (b2IslandSolverTask*)m_stackAllocator.Allocate(taskCount * sizeof(b2IslandSolverTask));
+	b2Task** taskList = (b2Task**)m_stackAllocator.Allocate(taskCount * sizeof(b2Task*));
+	for (int32 i = 0; i < taskCount; ++i)
+	{
+		b2IslandSolverTask* task = new (tasks + i) b2IslandSolverTask;
+		task->step = &step;
+		task->gravity = m_gravity;
+		task->allowSleep = m_allowSleep;
+		task->islands = islands;
+		task->islandCount = islandCount;
+		task->bodies = bodies;
+		task->contacts = contacts;
+		task->joints = joints;
+		task->thread = i;
+		task->allocator = m_solverAllocators[i];
+		taskList[i] = task;
+	}
+
+	if (taskCount == 1)
+	{
+		tasks[0].Execute();
+	}
+	else
+	{
+		m_taskExecutor->Run(taskList, taskCount);
+	}
+
+	for (int32 i = 0; i < taskCount; ++i)
+	{
+		m_profile.solveInit += tasks[i].profile.solveInit;
+		m_profile.solveVelocity += tasks[i].profile.solveVelocity;
+		m_profile.solvePosition += tasks[i].profile.solvePosition;
+		tasks[i].~b2IslandSolverTask();
+	}
+
+	// The islands had no listener while solving, report them now in the serial order
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		b2Island::ReportStoredImpulses(m_contactManager.m_contactListener,
+			contacts + islands[i].contactStart, islands[i].contactCount);
+	}
+
+	m_stackAllocator.Free(taskList);
+	m_stackAllocator.Free(tasks);
+	m_stackAllocator.Free(loads);
+}
+
 // Find TOI contacts and solve them.
 void b2World::SolveTOI(const b2TimeStep& step)
 {
@@ -34,6 +34,7 @@ class b2Body;
 class b2Draw;
 class b2Fixture;
 class b2Joint;
+struct b2IslandRange;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -194,6 +195,13 @@ public:
 	/// Get the current profile.
 	const b2Profile& GetProfile() const;
 
+	/// Solve independent islands in parallel through this executor. Each thread gets its
+	/// own stack allocator. Islands don't share anything but static bodies, which they only
+	/// read, and contacts are reported in the same order as in a serial step, so the result
+	/// doesn't depend on how the threads are scheduled. Pass NULL to solve serially.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+	b2TaskExecutor* GetTaskExecutor() const;
+
 private:
 
 	// m_flags
@@ -211,6 +219,9 @@ private:
 
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
+	void SolveIslandsConcurrently(const b2TimeStep& step, b2IslandRange* islands, int32 islandCount,
+		b2Body** bodies, b2Contact** contacts, b2Joint** joints, int32 threadCount);
+	void DestroySolverAllocators();
 
 	void DrawJoint(b2Joint* joint);
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
@@ -246,6 +257,10 @@ private:
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+
+	b2TaskExecutor* m_taskExecutor;
+	b2StackAllocator** m_solverAllocators;
+	int32 m_solverAllocatorCount;
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -331,6 +346,11 @@ inline const b2ContactManager& b2World::GetContactManager() const
 	return m_contactManager;
 }
 
+inline b2TaskExecutor* b2World::GetTaskExecutor() const
+{
+	return m_taskExecutor;
+}
+
 inline const b2Profile& b2World::GetProfile() const
 {
 	return m_profile;
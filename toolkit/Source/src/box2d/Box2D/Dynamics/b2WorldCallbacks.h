@@ -152,4 +152,28 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+/// A unit of work handed to a b2TaskExecutor.
+class b2Task
+{
+public:
+	virtual ~b2Task() {}
+
+	virtual void Execute() = 0;
+};
+
+/// Implement this to let the world solve independent islands on several threads.
+/// See b2World::SetTaskExecutor
+class b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// The number of tasks that may run at the same time, counting the calling thread.
+	virtual int32 GetThreadCount() const = 0;
+
+	/// Execute every task and only return once all of them are done. Never called
+	/// with more tasks than GetThreadCount.
+	virtual void Run(b2Task** tasks, int32 count) = 0;
+};
+
 #endif
@@ -22,6 +22,7 @@
 
 #include "ParticleFXEditor.h"
 #include "EditorCommon.h"
+#include "../engine/Resource/ETHParticleCache.h"
 #include <unicode/utf8converter.h>
 #include <sstream>
 
@@ -109,7 +110,7 @@ void ParticleEditor::DrawParticleSystem()
 		m_systemAngle = 180.0f;
 
 	m_timer.CalcLastFrame();
-	m_manager->UpdateParticleSystem(m_v2Pos, Vector3(m_v2Pos, 0), m_systemAngle, static_cast<unsigned long>(m_timer.GetElapsedTime() * 1000.0));
+	m_manager->UpdateParticleSystem(m_v2Pos, Vector3(m_v2Pos, 0), m_systemAngle, static_cast<unsigned long>(m_timer.GetElapsedTime() * 1000.0), Vector2(0,0));
 
 	m_provider->GetVideo()->SetScissor(Rect2D((int)m_menuWidth*2, 0, m_provider->GetVideo()->GetScreenSize().x-(int)m_menuWidth*2, m_provider->GetVideo()->GetScreenSize().y));
 	if ((m_boundingSphere.IsActive() || m_boundingSphere.IsMouseOver()) && m_system.boundingSphere >= 1)
@@ -391,6 +392,13 @@ void ParticleEditor::SetMenuConstants()
 	m_allAtOnce.SetScrollAdd(1.0f);
 	m_allAtOnce.SetDescription(L"All-at-once particle relasing (1=true/0=false)");
 
+	m_instanced.SetupMenu(m_provider->GetVideo(), m_provider->GetInput(), m_menuSize, m_menuWidth, 9, false);
+	m_instanced.SetConstant((m_system.instanced) ? 1.0f : 0.0f);
+	m_instanced.SetClamp(true, 0, 1);
+	m_instanced.SetText(L"Instanced:");
+	m_instanced.SetScrollAdd(1.0f);
+	m_instanced.SetDescription(L"Share one simulation among all endless emitters of this effect (1=true/0=false)");
+
 	m_spriteCut[0].SetupMenu(m_provider->GetVideo(), m_provider->GetInput(), m_menuSize, m_menuWidth, 9, false);
 	m_spriteCut[0].SetConstant(static_cast<float>(m_system.v2SpriteCut.x));
 	m_spriteCut[0].SetClamp(true, 1, 9999);
@@ -536,6 +544,8 @@ void ParticleEditor::ParticlePanel()
 		char path[___OUTPUT_LENGTH], file[___OUTPUT_LENGTH];
 		if (OpenSystem(path, file))
 		{
+			// the file may have been changed since it was cached
+			m_provider->GetParticleCache()->Release(utf8::c(path).wstr());
 			m_manager = ETHParticleManagerPtr(
 				new ETHParticleManager(m_provider, utf8::c(path).wstr(), m_v2Pos, Vector3(m_v2Pos, 0), m_systemAngle, 1.0f));
 			m_manager->SetTileZ(0.0f);
@@ -638,6 +648,7 @@ void ParticleEditor::ParticlePanel()
 
 		m_system.boundingSphere = m_boundingSphere.PlaceInput(Vector2(0.0f,menu), Vector2(0.0f, v2ScreenDim.y-m_menuSize), m_menuSize); menu += m_menuSize;
 		m_system.allAtOnce = (bool)(m_allAtOnce.PlaceInput(Vector2(0.0f,menu), Vector2(0.0f, v2ScreenDim.y-m_menuSize), m_menuSize) != 0); menu += m_menuSize;
+		m_system.instanced = (bool)(m_instanced.PlaceInput(Vector2(0.0f,menu), Vector2(0.0f, v2ScreenDim.y-m_menuSize), m_menuSize) != 0); menu += m_menuSize;
 		menu += m_menuSize/2;
 
 		m_system.v3StartPoint.x = m_startPoint[0].PlaceInput(Vector2(0.0f,menu), Vector2(0.0f, v2ScreenDim.y-m_menuSize), m_menuSize); menu += m_menuSize;
@@ -738,6 +749,7 @@ void ParticleEditor::ResetSystem()
 	m_system.emissive = Vector3(1,1,1);
 	m_system.boundingSphere = 512.0f;
 	m_system.allAtOnce = false;
+	m_system.instanced = false;
 
 	//CreateParticles();
 }
@@ -72,6 +72,7 @@ class ParticleEditor : public EditorBase
 	GSGUI_FLOAT_INPUT m_angleStart;
 	GSGUI_FLOAT_INPUT m_boundingSphere;
 	GSGUI_FLOAT_INPUT m_allAtOnce;
+	GSGUI_FLOAT_INPUT m_instanced;
 
 	GSGUI_FLOAT_INPUT m_spriteCut[2];
 
@@ -23,6 +23,8 @@
 #include "ETHEngine.h"
 #include "Script/ETHScriptObjRegister.h"
 #include "Script/ETHBinaryStream.h"
+#include "Script/ETHCallbackFunctionCache.h"
+#include "Script/ETHScriptProfiler.h"
 #include "ETHCommon.h"
 
 #ifdef GS2D_STR_TYPE_WCHAR
@@ -49,6 +51,9 @@ gs2d::BaseApplicationPtr gs2d::CreateBaseApplication()
 #	define ETH_BYTECODE_FILE_NAME GS_L("game.bin")
 #endif
 
+// holds the hash of the source code the byte code file was compiled from
+#define ETH_BYTECODE_KEY_FILE_SUFFIX GS_L(".key")
+
 ETHEngine::ETHEngine(const bool testing, const bool compileAndRun, const str_type::string& startResourcePath) :
 	ETH_DEFAULT_MAIN_SCRIPT_FILE(_ETH_DEFAULT_MAIN_SCRIPT_FILE),
 	ETH_DEFAULT_MAIN_BYTECODE_FILE(ETH_BYTECODE_FILE_NAME),
@@ -63,7 +68,9 @@ ETHEngine::ETHEngine(const bool testing, const bool compileAndRun, const str_typ
 
 ETHEngine::~ETHEngine()
 {
+	m_coroutineScheduler.ReleaseContexts(); // drop the entity references held by coroutines while the scene is alive
 	m_pScene.reset(); // destroy the scene first, so the script engine is free to run garbage collection
+	ETHScriptProfiler::Stop();
 	if (m_pScriptContext)
 	{
 		m_pScriptContext->Release();
@@ -83,6 +90,11 @@ ETHResourceProviderPtr ETHEngine::GetProvider()
 	return m_provider;
 }
 
+void ETHEngine::SetScriptProfileFile(const str_type::string& fileName)
+{
+	m_scriptProfileFile = fileName;
+}
+
 void ETHEngine::Start(VideoPtr video, InputPtr input, AudioPtr audio)
 {
 	ETH_WINDOW_ENML_FILE file(m_startResourcePath + ETH_APP_PROPERTIES_FILE, video->GetFileManager());
@@ -129,9 +141,8 @@ void ETHEngine::Start(VideoPtr video, InputPtr input, AudioPtr audio)
 Application::APP_STATUS ETHEngine::Update(unsigned long lastFrameDeltaTimeMS)
 {
 	SetLastFrameElapsedTime(lastFrameDeltaTimeMS);
-
-	// run garbage collector
-	GarbageCollect(m_gcMode, m_pASEngine);
+	const VideoPtr& video = m_provider->GetVideo();
+	const float frameStartTime = video->GetElapsedTimeF();
 
 	//update timer
 	m_timer.CalcLastFrame();
@@ -147,9 +158,18 @@ Application::APP_STATUS ETHEngine::Update(unsigned long lastFrameDeltaTimeMS)
 
 	RunOnSceneUpdateFunction();
 
+	// carry on with the coroutines that have yielded, within their own time budget
+	m_coroutineScheduler.Resume(video);
+
 	if (m_pScene)
 		m_pScene->UpdateTemporary(lastFrameDeltaTimeMS);
 
+	// run garbage collector with what is left of the frame time
+	if (m_gcMode == ONE_STEP)
+		m_gcScheduler.Collect(m_pASEngine, video, frameStartTime);
+	else
+		GarbageCollect(m_gcMode, m_pASEngine);
+
 	if (!LoadNextSceneIfRequested())
 		Abort();
 
@@ -165,7 +185,7 @@ bool ETHEngine::LoadNextSceneIfRequested()
 	{
 		LoadScene(m_nextScene.GetSceneName(), m_nextScene.GetBucketSize());
 		m_nextScene.Reset();
-		GarbageCollect(DESTROY_ALL_GARBAGE, m_pASEngine);
+		m_gcScheduler.RunFullCycle(m_pASEngine);
 	}
 	else
 	{
@@ -180,6 +200,9 @@ bool ETHEngine::LoadNextSceneIfRequested()
 
 void ETHEngine::RenderFrame()
 {
+	const VideoPtr& video = m_provider->GetVideo();
+	const float renderStartTime = video->GetElapsedTimeF();
+
 	m_backBuffer->BeginRendering();
 
 	// draw scene (if there's any)
@@ -191,6 +214,9 @@ void ETHEngine::RenderFrame()
 
 	m_backBuffer->EndRendering();
 
+	// the time spent waiting for presentation is still available to the garbage collector
+	m_gcScheduler.SetRenderTime(video->GetElapsedTimeF() - renderStartTime);
+
 	m_backBuffer->Present();
 }
 
@@ -253,6 +279,17 @@ bool ETHEngine::PrepareScriptingEngine()
 	if (!CheckAngelScriptError(r, GS_L("Failed while setting message callback.")))
 		return false;
 
+	#ifdef ETH_JIT_COMPILER_ENABLED
+	// JitEntry instructions mark the points where native code may take over from the VM
+	r = m_pASEngine->SetEngineProperty(asEP_INCLUDE_JIT_INSTRUCTIONS, 1);
+	if (!CheckAngelScriptError(r, GS_L("Failed while enabling JIT instructions.")))
+		return false;
+
+	r = m_pASEngine->SetJITCompiler(&m_jitCompiler);
+	if (!CheckAngelScriptError(r, GS_L("Failed while setting the JIT compiler.")))
+		return false;
+	#endif
+
 	ETHGlobal::RegisterEnumTypes(m_pASEngine);
 	ETHGlobal::RegisterGlobalProperties(m_pASEngine);
 	ETHGlobal::RegisterAllObjects(m_pASEngine);
@@ -261,6 +298,13 @@ bool ETHEngine::PrepareScriptingEngine()
 	m_pScriptContext = m_pASEngine->CreateContext();
 	m_pConstructorContext = m_pASEngine->CreateContext();
 
+	if (!m_scriptProfileFile.empty())
+	{
+		ETHScriptProfiler::Start(m_provider->GetVideo(), m_pASEngine, m_scriptProfileFile);
+		ETHScriptProfiler::AttachContext(m_pScriptContext);
+		ETHScriptProfiler::AttachContext(m_pConstructorContext);
+	}
+
 	if (!BuildModule())
 		return false;
 
@@ -269,6 +313,9 @@ bool ETHEngine::PrepareScriptingEngine()
 
 bool ETHEngine::BuildModule()
 {
+	// function IDs found in the old module are no longer valid
+	ETHCallbackFunctionCache::Clear();
+
 	const str_type::string resourcePath = m_provider->GetResourcePath();
 	const str_type::string mainScript = resourcePath + ETH_DEFAULT_MAIN_SCRIPT_FILE;
 	const str_type::string byteCodeWriteFile = m_provider->GetByteCodeSavePath() + ETH_DEFAULT_MAIN_BYTECODE_FILE;
@@ -319,6 +366,38 @@ bool ETHEngine::BuildModule()
 		if (!CheckAngelScriptError(r, ss.str()))
 			return false;
 
+		// skip the compilation if the last byte code written was built from the very same source
+		const asQWORD cacheKey = ComputeByteCodeCacheKey(builder.GetSourceHash());
+		const str_type::string cacheKeyFile = byteCodeWriteFile + ETH_BYTECODE_KEY_FILE_SUFFIX;
+		if (IsByteCodeCacheValid(cacheKeyFile, cacheKey))
+		{
+			// loading into a fresh module releases the script sections added by the builder
+			m_pASModule = CScriptBuilder::GetModule(m_pASEngine, ETH_SCRIPT_MODULE, asGM_ALWAYS_CREATE);
+			ETHBinaryStream stream(m_provider->GetVideo()->GetFileManager());
+			if (stream.OpenR(byteCodeWriteFile))
+			{
+				r = m_pASModule->LoadByteCode(&stream);
+				stream.CloseR();
+				if (r >= 0)
+				{
+					ETH_STREAM_DECL(ss) << GS_L("Source-code unchanged, game script loaded from cached byte code: ") << byteCodeWriteFile;
+					m_provider->Log(ss.str(), Platform::Logger::INFO);
+					return true;
+				}
+			}
+
+			ETH_STREAM_DECL(ss) << GS_L("Couldn't load cached byte code, compiling the game script");
+			m_provider->Log(ss.str(), Platform::Logger::WARNING);
+
+			// the module the builder was filling has been discarded
+			if (builder.StartNewModule(m_pASEngine, ETH_SCRIPT_MODULE.c_str()) < 0
+				|| builder.AddSectionFromFile(mainScript.c_str()) < 0)
+			{
+				ShowMessage(GS_L("Failed while reloading the main script."), ETH_ERROR);
+				return false;
+			}
+		}
+
 		// builds the module
 		const VideoPtr& video = m_provider->GetVideo();
 		const unsigned long buildTime = video->GetElapsedTime();
@@ -339,6 +418,7 @@ bool ETHEngine::BuildModule()
 			stream.CloseW();
 
 			SaveByteCodeReadme(resourcePath);
+			SaveByteCodeCacheKey(cacheKeyFile, cacheKey);
 		}
 		else
 		{
@@ -377,6 +457,78 @@ bool ETHEngine::BuildModule()
 	return true;
 }
 
+asQWORD ETHEngine::ComputeByteCodeCacheKey(const asQWORD sourceHash) const
+{
+	const asDWORD version = ANGELSCRIPT_VERSION;
+	asQWORD key = CScriptBuilder::HashBytes(&sourceHash, sizeof(sourceHash));
+	key = CScriptBuilder::HashBytes(&version, sizeof(version), key);
+
+	// byte code built with JitEntry instructions can't be shared with builds that have no JIT
+	const asPWORD jitInstructions = m_pASEngine->GetEngineProperty(asEP_INCLUDE_JIT_INSTRUCTIONS);
+	key = CScriptBuilder::HashBytes(&jitInstructions, sizeof(jitInstructions), key);
+
+	// the byte code refers to the registered application interface, so any change
+	// in the engine functions or objects must invalidate it as well
+	const int functionCount = m_pASEngine->GetGlobalFunctionCount();
+	for (int t = 0; t < functionCount; t++)
+	{
+		const asIScriptFunction* pFunction = m_pASEngine->GetFunctionDescriptorById(m_pASEngine->GetGlobalFunctionIdByIndex(t));
+		const char* declaration = pFunction->GetDeclaration();
+		key = CScriptBuilder::HashBytes(declaration, strlen(declaration) + 1, key);
+	}
+
+	const int typeCount = m_pASEngine->GetObjectTypeCount();
+	for (int t = 0; t < typeCount; t++)
+	{
+		const asIObjectType* pType = m_pASEngine->GetObjectTypeByIndex(t);
+		const char* name = pType->GetName();
+		key = CScriptBuilder::HashBytes(name, strlen(name) + 1, key);
+
+		const int methodCount = pType->GetMethodCount();
+		for (int m = 0; m < methodCount; m++)
+		{
+			const char* declaration = m_pASEngine->GetFunctionDescriptorById(pType->GetMethodIdByIndex(m))->GetDeclaration();
+			key = CScriptBuilder::HashBytes(declaration, strlen(declaration) + 1, key);
+		}
+	}
+
+	const int propertyCount = m_pASEngine->GetGlobalPropertyCount();
+	for (int t = 0; t < propertyCount; t++)
+	{
+		const char* name = 0;
+		int typeId = 0;
+		m_pASEngine->GetGlobalPropertyByIndex(t, &name, &typeId);
+		key = CScriptBuilder::HashBytes(name, strlen(name) + 1, key);
+		key = CScriptBuilder::HashBytes(&typeId, sizeof(typeId), key);
+	}
+	return key;
+}
+
+bool ETHEngine::IsByteCodeCacheValid(const str_type::string& keyFile, const asQWORD key) const
+{
+	const Platform::FileManagerPtr& fileManager = m_provider->GetVideo()->GetFileManager();
+	if (!ETHGlobal::FileExists(keyFile, fileManager))
+		return false;
+
+	asQWORD savedKey = 0;
+	ETHBinaryStream stream(fileManager);
+	if (!stream.OpenR(keyFile))
+		return false;
+	stream.Read(&savedKey, sizeof(savedKey));
+	stream.CloseR();
+	return (savedKey == key);
+}
+
+void ETHEngine::SaveByteCodeCacheKey(const str_type::string& keyFile, const asQWORD key) const
+{
+	ETHBinaryStream stream(m_provider->GetVideo()->GetFileManager());
+	if (stream.OpenW(keyFile))
+	{
+		stream.Write(&key, sizeof(key));
+		stream.CloseW();
+	}
+}
+
 int ETHEngine::GetMainFunctionId() const
 {
 	// finds the main function
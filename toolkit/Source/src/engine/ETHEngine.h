@@ -26,6 +26,8 @@
 #include <gs2dframework.h>
 #include "Resource/ETHResourceProvider.h"
 #include "Script/ETHScriptWrapper.h"
+#include "Script/ETHGarbageCollectScheduler.h"
+#include "Script/ETHJITCompiler.h"
 #include "Shader/ETHShaderManager.h"
 
 #define _ETH_DEFAULT_MAIN_SCRIPT_FILE (GS_L("main.angelscript"))
@@ -50,6 +52,9 @@ class ETHEngine : public gs2d::BaseApplication, public ETHScriptWrapper
 	bool m_hasBeenResumed;
 
 	const str_type::string m_startResourcePath;
+	ETHGarbageCollectScheduler m_gcScheduler;
+	ETHJITCompiler m_jitCompiler;
+	str_type::string m_scriptProfileFile;
 
 	static void MessageCallback(const asSMessageInfo *msg);
 	static bool CheckAngelScriptError(const int r, const str_type::string &description);
@@ -58,6 +63,9 @@ class ETHEngine : public gs2d::BaseApplication, public ETHScriptWrapper
 
 	bool PrepareScriptingEngine();
 	bool BuildModule();
+	asQWORD ComputeByteCodeCacheKey(const asQWORD sourceHash) const;
+	bool IsByteCodeCacheValid(const str_type::string& keyFile, const asQWORD key) const;
+	void SaveByteCodeCacheKey(const str_type::string& keyFile, const asQWORD key) const;
 	int GetMainFunctionId() const;
 	bool RunOnSceneUpdateFunction() const;
 	bool RunOnResumeFunction() const;
@@ -80,6 +88,10 @@ public:
 	void Restore();
 
 	ETHResourceProviderPtr GetProvider();
+
+	/// Enables the script profiler, which writes collapsed call stacks to fileName when the engine
+	/// is destroyed. Must be called before Start
+	void SetScriptProfileFile(const str_type::string& fileName);
 };
 
 typedef boost::shared_ptr<ETHEngine> ETHEnginePtr;
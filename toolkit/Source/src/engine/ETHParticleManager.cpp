@@ -21,10 +21,13 @@
 --------------------------------------------------------------------------------------*/
 
 #include "ETHParticleManager.h"
+#include "Resource/ETHParticleCache.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+std::map<ETHParticleManager::INSTANCE_KEY, boost::weak_ptr<ETHParticleManager> > ETHParticleManager::m_instanceMasters;
+
 ETH_PARTICLE::ETH_PARTICLE()
 {
 	released = false;
@@ -89,6 +92,7 @@ void ETH_PARTICLE_SYSTEM::Reset()
 	angleStart = 0.0f;
 	emissive = Vector3(1,1,1);
 	allAtOnce = false;
+	instanced = false;
 	boundingSphere = 512.0f;
 	soundFXFile = GS_L("");
 	v2SpriteCut = Vector2i(1,1);
@@ -103,6 +107,10 @@ bool ETH_PARTICLE_SYSTEM::ReadFromXMLFile(TiXmlElement *pElement)
 	pElement->QueryIntAttribute(GS_L("allAtOnce"), &tempAllAtOnce);
 	allAtOnce = static_cast<ETH_BOOL>(tempAllAtOnce);
 
+	int tempInstanced = static_cast<int>(instanced);
+	pElement->QueryIntAttribute(GS_L("instanced"), &tempInstanced);
+	instanced = static_cast<ETH_BOOL>(tempInstanced);
+
 	pElement->QueryIntAttribute(GS_L("alphaMode"), (int*)&alphaMode);
 	pElement->QueryIntAttribute(GS_L("repeat"), &repeat);
 	pElement->QueryFloatAttribute(GS_L("boundingSphere"), &boundingSphere);
@@ -346,6 +354,7 @@ bool ETH_PARTICLE_SYSTEM::WriteToXMLFile(TiXmlElement *pRoot) const
 
 	pParticleRoot->SetAttribute(GS_L("particles"), nParticles);
 	pParticleRoot->SetAttribute(GS_L("allAtOnce"), allAtOnce);
+	pParticleRoot->SetAttribute(GS_L("instanced"), instanced);
 	pParticleRoot->SetAttribute(GS_L("alphaMode"), alphaMode);
 	pParticleRoot->SetAttribute(GS_L("repeat"), repeat);
 	pParticleRoot->SetAttribute(GS_L("animationMode"), animationMode);
@@ -379,8 +388,8 @@ ETHParticleManager::ETHParticleManager(ETHResourceProviderPtr provider, const st
 	const Vector3 &v3Pos, const float angle, const float entityVolume) :
 	m_provider(provider)
 {
-	ETH_PARTICLE_SYSTEM partSystem;
-	if (partSystem.ReadFromFile(file, m_provider->GetVideo()->GetFileManager()))
+	const ETHParticleSystemPtr partSystem = m_provider->GetParticleCache()->Get(file, m_provider->GetVideo()->GetFileManager());
+	if (partSystem)
 	{
 		CreateParticleSystem(partSystem, v2Pos, v3Pos, angle, entityVolume);
 	}
@@ -394,15 +403,22 @@ ETHParticleManager::ETHParticleManager(ETHResourceProviderPtr provider, const st
 ETHParticleManager::ETHParticleManager(ETHResourceProviderPtr provider, const ETH_PARTICLE_SYSTEM &partSystem, const Vector2 &v2Pos,
 									   const Vector3 &v3Pos, const float angle, const float entityVolume) :
 	m_provider(provider)
+{
+	CreateParticleSystem(ETHParticleSystemPtr(new ETH_PARTICLE_SYSTEM(partSystem)), v2Pos, v3Pos, angle, entityVolume);
+}
+
+ETHParticleManager::ETHParticleManager(ETHResourceProviderPtr provider, const ETHParticleSystemPtr &partSystem, const Vector2 &v2Pos,
+									   const Vector3 &v3Pos, const float angle, const float entityVolume) :
+	m_provider(provider)
 {
 	CreateParticleSystem(partSystem, v2Pos, v3Pos, angle, entityVolume);
 }
 
-bool ETHParticleManager::CreateParticleSystem(const ETH_PARTICLE_SYSTEM &partSystem, const Vector2 &v2Pos,
+bool ETHParticleManager::CreateParticleSystem(const ETHParticleSystemPtr &partSystem, const Vector2 &v2Pos,
 											  const Vector3 &v3Pos, const float angle,  const float entityVolume)
 {
 	GS2D_UNUSED_ARGUMENT(v3Pos);
-	if (partSystem.nParticles <= 0)
+	if (partSystem->nParticles <= 0)
 	{
 		ETH_STREAM_DECL(ss) << GS_L("ETHParticleManager::CreateParticleSystem: The number of particles must be greater than 0.");
 		m_provider->Log(ss.str(), Platform::FileLogger::ERROR);
@@ -412,6 +428,7 @@ bool ETHParticleManager::CreateParticleSystem(const ETH_PARTICLE_SYSTEM &partSys
 	m_finished = false;
 	m_killed = false;
 	m_nActiveParticles = 0;
+	m_culledElapsedTime = 0;
 	m_soundVolume = 1.0f;
 	m_isSoundLooping = false;
 	m_isSoundStopped = false;
@@ -419,10 +436,17 @@ bool ETHParticleManager::CreateParticleSystem(const ETH_PARTICLE_SYSTEM &partSys
 	m_generalVolume = 1.0f;
 	m_system = partSystem;
 	m_entityVolume = entityVolume;
+	m_instancingPending = (m_system->instanced == ETH_TRUE);
+	m_v2InstancePos = v2Pos;
+	m_v3InstancePos = v3Pos;
+	m_lastSharedUpdate = 0;
 
-	if (m_system.bitmapFile.empty())
+	// each emitter owns its random stream
+	m_random.Seed(static_cast<unsigned int>(Randomizer::Int(0x7FFFFFFF)));
+
+	if (m_system->bitmapFile.empty())
 	{
-		m_system.bitmapFile = ETH_DEFAULT_PARTICLE_BITMAP;
+		GetEditableSystem()->bitmapFile = ETH_DEFAULT_PARTICLE_BITMAP;
 	}
 
 	ETHGraphicResourceManagerPtr graphics = m_provider->GetGraphicResourceManager();
@@ -433,32 +457,32 @@ bool ETHParticleManager::CreateParticleSystem(const ETH_PARTICLE_SYSTEM &partSys
 	const str_type::string& programPath  = m_provider->GetProgramPath();
 	const str_type::string currentPath = (resourcePath.empty()) ? programPath : resourcePath;
 
-	m_pBMP = graphics->GetPointer(m_provider->GetVideo(), m_system.bitmapFile, currentPath,
-		ETHDirectories::GetParticlesPath(), (m_system.alphaMode == GSAM_ADD));
+	m_pBMP = graphics->GetPointer(m_provider->GetVideo(), m_system->bitmapFile, currentPath,
+		ETHDirectories::GetParticlesPath(), (m_system->alphaMode == GSAM_ADD));
 
 	// find the particle sound effect
-	if (m_system.soundFXFile != GS_L(""))
+	if (m_system->soundFXFile != GS_L(""))
 	{
-		m_pSound = samples->GetPointer(m_provider->GetAudio(), m_system.soundFXFile, m_provider->GetResourcePath(),
+		m_pSound = samples->GetPointer(m_provider->GetAudio(), m_system->soundFXFile, m_provider->GetResourcePath(),
 			ETHDirectories::GetSoundFXPath(), GSST_SOUND_EFFECT);
 	}
 
-	if (m_system.allAtOnce)
+	if (m_system->allAtOnce)
 	{
-		m_nActiveParticles = m_system.nParticles;
+		m_nActiveParticles = m_system->nParticles;
 	}
 	else
 	{
 		m_nActiveParticles = 0;
 	}
 
-	m_particles.resize(m_system.nParticles);
+	m_particles.resize(m_system->nParticles);
 
 	Matrix4x4 rot = RotateZ(DegreeToRadian(angle));
-	for (int t=0; t<m_system.nParticles; t++)
+	for (int t=0; t<m_system->nParticles; t++)
 	{
 		m_particles[t].id = t;
-		//if (m_system.allAtOnce)
+		//if (m_system->allAtOnce)
 		//	m_particles[t].released = true;
 		//else
 		m_particles[t].released = false;
@@ -485,38 +509,40 @@ void ETHParticleManager::StopSFX(const bool stopped)
 
 Vector3 ETHParticleManager::GetStartPos() const
 {
-	return m_system.v3StartPoint;
+	return m_system->v3StartPoint;
 }
 
 void ETHParticleManager::SetStartPos(const Vector3 v3Pos)
 {
-	m_system.v3StartPoint = v3Pos;
+	GetEditableSystem()->v3StartPoint = v3Pos;
 }
 
 float ETHParticleManager::GetBoundingRadius() const
 {
-	return m_system.boundingSphere/2;
+	return m_system->boundingSphere/2;
 }
 
 str_type::string ETHParticleManager::GetBitmapName() const
 {
-	return m_system.bitmapFile;
+	return m_system->bitmapFile;
 }
 
 str_type::string ETHParticleManager::GetSoundName() const
 {
-	return m_system.soundFXFile;
+	return m_system->soundFXFile;
 }
 
 void ETHParticleManager::Kill(const bool kill)
 {
+	Detach();
 	m_killed = kill;
 }
 
 void ETHParticleManager::SetSystem(const ETH_PARTICLE_SYSTEM &partSystem)
 {
-	//partSystem.nParticles = m_system.nParticles;
-	m_system = partSystem;
+	//partSystem.nParticles = m_system->nParticles;
+	Detach();
+	m_system = ETHParticleSystemPtr(new ETH_PARTICLE_SYSTEM(partSystem));
 }
 
 void ETHParticleManager::SetParticleBitmap(SpritePtr pBMP)
@@ -531,7 +557,19 @@ SpritePtr ETHParticleManager::GetParticleBitmap()
 
 const ETH_PARTICLE_SYSTEM *ETHParticleManager::GetSystem() const
 {
-	return &m_system;
+	return m_system.get();
+}
+
+ETH_PARTICLE_SYSTEM* ETHParticleManager::GetEditableSystem()
+{
+	// the definition may be shared with the particle cache or with other
+	// entities, so we must have our own copy before changing anything
+	Detach();
+	if (!m_system.unique())
+	{
+		m_system = ETHParticleSystemPtr(new ETH_PARTICLE_SYSTEM(*m_system));
+	}
+	return m_system.get();
 }
 
 void ETHParticleManager::SetSoundEffect(AudioSamplePtr pSound)
@@ -547,7 +585,7 @@ AudioSamplePtr ETHParticleManager::GetSoundEffect()
 // Returns true if it has a SFX
 bool ETHParticleManager::HasSoundEffect() const
 {
-	return (m_system.soundFXFile != GS_L(""));
+	return (m_system->soundFXFile != GS_L(""));
 }
 
 bool ETHParticleManager::IsSoundLooping() const
@@ -555,18 +593,196 @@ bool ETHParticleManager::IsSoundLooping() const
 	return m_isSoundLooping;
 }
 
-bool ETHParticleManager::UpdateParticleSystem(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const unsigned long lastFrameElapsedTime)
+bool ETHParticleManager::UpdateParticleSystem(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const unsigned long lastFrameElapsedTime,
+											   const Vector2 &parallaxOffset)
 {
-	bool anythingDrawn = false;
 	const unsigned long cappedLastFrameElapsedTime = Min(lastFrameElapsedTime, static_cast<unsigned long>(250));
 	const float frameSpeed = static_cast<float>((static_cast<double>(cappedLastFrameElapsedTime) / 1000.0) * 60.0);
 
+	// by now the owner is done setting the system up, so we know whether it can be shared
+	if (m_instancingPending)
+	{
+		m_instancingPending = false;
+		AttachToMaster(angle);
+	}
+
+	if (m_master)
+	{
+		m_v2InstancePos = v2Pos;
+		m_v3InstancePos = v3Pos;
+		if (IsOnScreen(v2Pos, parallaxOffset))
+		{
+			m_master->UpdateShared(m_provider->GetVideo()->GetElapsedTime());
+			m_nActiveParticles = m_master->m_nActiveParticles;
+			m_finished = m_master->m_finished;
+		}
+		HandleSoundPlayback(v2Pos, frameSpeed);
+		return true;
+	}
+
+	// nobody can see it, so just accumulate time and simulate it once in a while
+	// at a reduced rate. That is still enough to let finite systems come to an end
+	if (!IsOnScreen(v2Pos, parallaxOffset))
+	{
+		m_culledElapsedTime += lastFrameElapsedTime;
+		if (m_culledElapsedTime >= _ETH_PARTICLE_CULLED_UPDATE_INTERVAL)
+		{
+			FastForward(v2Pos, v3Pos, angle, m_culledElapsedTime);
+			m_culledElapsedTime = 0;
+		}
+
+		// the sound still follows the system, and looping sounds must stop once it's over
+		HandleSoundPlayback(v2Pos, frameSpeed);
+		return true;
+	}
+
+	// it's back on screen, catch up with the time it spent suspended
+	if (m_culledElapsedTime > 0)
+	{
+		FastForward(v2Pos, v3Pos, angle, m_culledElapsedTime);
+		m_culledElapsedTime = 0;
+	}
+
+	Simulate(v2Pos, v3Pos, angle, lastFrameElapsedTime, frameSpeed);
+
+	// manages the sound
+	HandleSoundPlayback(v2Pos, frameSpeed);
+
+	return true;
+}
+
+void ETHParticleManager::FastForward(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const unsigned long milliseconds,
+									 const unsigned long stepMS)
+{
+	Detach();
+	const unsigned long step = Max(stepMS, static_cast<unsigned long>(1));
+
+	// finite systems stop on their own, but endless ones would simulate whatever scripts ask for
+	unsigned long remaining = IsEndless() ? Min(milliseconds, GetMaxCatchUpTime()) : milliseconds;
+	while (remaining > 0 && !m_finished)
+	{
+		const unsigned long elapsed = Min(remaining, step);
+		const float frameSpeed = static_cast<float>((static_cast<double>(elapsed) / 1000.0) * 60.0);
+		Simulate(v2Pos, v3Pos, angle, elapsed, frameSpeed);
+		remaining -= elapsed;
+	}
+}
+
+bool ETHParticleManager::IsOnScreen(const Vector2 &v2Pos, const Vector2 &parallaxOffset) const
+{
+	const VideoPtr& video = m_provider->GetVideo();
+	const Vector2 v2Min(video->GetCameraPos());
+	const Vector2 v2Max(v2Min + video->GetScreenSizeF());
+	const Vector2 v2Center(v2Pos + parallaxOffset + ETHGlobal::ToVector2(m_system->v3StartPoint));
+	const float radius = GetBoundingRadius() + _ETH_PARTICLE_CULLING_MARGIN;
+	return (v2Center.x + radius >= v2Min.x && v2Center.x - radius <= v2Max.x
+		 && v2Center.y + radius >= v2Min.y && v2Center.y - radius <= v2Max.y);
+}
+
+bool ETHParticleManager::IsInstanced() const
+{
+	return (m_master.get() != 0);
+}
+
+bool ETHParticleManager::AttachToMaster(const float angle)
+{
+	if (!m_system->instanced || !IsEndless() || Killed() || angle != 0.0f)
+		return false;
+
+	// emitters are spread among a few masters that run with different
+	// phases, so that instances don't look perfectly synchronized
+	const unsigned int phase = m_random.UInt() % _ETH_PARTICLE_INSTANCE_PHASES;
+	const INSTANCE_KEY key(m_system.get(), phase);
+
+	boost::shared_ptr<ETHParticleManager> master = m_instanceMasters[key].lock();
+	if (!master)
+	{
+		// forget masters whose instances are all gone
+		for (std::map<INSTANCE_KEY, boost::weak_ptr<ETHParticleManager> >::iterator iter = m_instanceMasters.begin();
+			iter != m_instanceMasters.end();)
+		{
+			if (iter->second.expired() && iter->first != key)
+				m_instanceMasters.erase(iter++);
+			else
+				++iter;
+		}
+
+		master = boost::shared_ptr<ETHParticleManager>(
+			new ETHParticleManager(m_provider, m_system, Vector2(0,0), Vector3(0,0,0), 0.0f, m_entityVolume));
+		master->m_instancingPending = false;
+		const float phaseTime = (m_system->lifeTime + m_system->randomizeLifeTime)
+			* static_cast<float>(phase + 1) / static_cast<float>(_ETH_PARTICLE_INSTANCE_PHASES);
+		master->FastForward(Vector2(0,0), Vector3(0,0,0), 0.0f, static_cast<unsigned long>(phaseTime));
+		master->m_lastSharedUpdate = m_provider->GetVideo()->GetElapsedTime();
+		m_instanceMasters[key] = master;
+	}
+
+	m_master = master;
+	m_nActiveParticles = m_master->m_nActiveParticles;
+	m_finished = m_master->m_finished;
+	std::vector<ETH_PARTICLE>().swap(m_particles);
+	return true;
+}
+
+void ETHParticleManager::Detach()
+{
+	m_instancingPending = false;
+	if (!m_master)
+		return;
+
+	m_particles = m_master->m_particles;
+	const Vector3 v3Offset(m_v2InstancePos, m_v3InstancePos.z);
+	for (std::size_t t=0; t<m_particles.size(); t++)
+	{
+		m_particles[t].v2Pos = m_particles[t].v2Pos + m_v2InstancePos;
+		m_particles[t].v3StartPoint = m_particles[t].v3StartPoint + v3Offset;
+	}
+	m_nActiveParticles = m_master->m_nActiveParticles;
+	m_finished = m_master->m_finished;
+	m_master.reset();
+}
+
+void ETHParticleManager::UpdateShared(const unsigned long currentTime)
+{
+	if (currentTime <= m_lastSharedUpdate)
+		return;
+
+	// no need to catch up on more than the particles remember after nobody has seen it for a while
+	const unsigned long maxCatchUp = GetMaxCatchUpTime();
+	const unsigned long elapsed = currentTime - m_lastSharedUpdate;
+	m_lastSharedUpdate = currentTime;
+
+	if (elapsed <= 250)
+	{
+		const float frameSpeed = static_cast<float>((static_cast<double>(elapsed) / 1000.0) * 60.0);
+		Simulate(Vector2(0,0), Vector3(0,0,0), 0.0f, elapsed, frameSpeed);
+	}
+	else
+	{
+		FastForward(Vector2(0,0), Vector3(0,0,0), 0.0f, Min(elapsed, Max(maxCatchUp, static_cast<unsigned long>(250))));
+	}
+}
+
+unsigned long ETHParticleManager::GetMaxCatchUpTime() const
+{
+	return static_cast<unsigned long>((m_system->lifeTime + m_system->randomizeLifeTime) * 2.0f);
+}
+
+void ETHParticleManager::SetRandomSeed(const unsigned int seed, const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle)
+{
+	m_random.Seed(seed);
+	ResetParticles(v2Pos, v3Pos, angle);
+}
+
+void ETHParticleManager::Simulate(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const unsigned long elapsedTime, const float frameSpeed)
+{
+	bool anythingDrawn = false;
 	Matrix4x4 rot = RotateZ(DegreeToRadian(angle));
 	m_nActiveParticles = 0;
-	for (int t=0; t<m_system.nParticles; t++)
+	for (int t=0; t<m_system->nParticles; t++)
 	{
-		if (m_system.repeat>0)
-			if (m_particles[t].repeat >= m_system.repeat)
+		if (m_system->repeat>0)
+			if (m_particles[t].repeat >= m_system->repeat)
 				continue;
 
 		// check how many particles are active
@@ -577,15 +793,15 @@ bool ETHParticleManager::UpdateParticleSystem(const Vector2 &v2Pos, const Vector
 		}
 
 		anythingDrawn = true;
-		m_particles[t].elapsed += lastFrameElapsedTime;
+		m_particles[t].elapsed += elapsedTime;
 
 		if (!m_particles[t].released)
 		{
 			// if we shouldn't release all particles at the same time, check if it's time to release this particle
 			const float releaseTime = 
-				((m_system.lifeTime+m_system.randomizeLifeTime)*(static_cast<float>(m_particles[t].id)/static_cast<float>(m_system.nParticles)));
+				((m_system->lifeTime+m_system->randomizeLifeTime)*(static_cast<float>(m_particles[t].id)/static_cast<float>(m_system->nParticles)));
 
-			if (m_particles[t].elapsed > releaseTime || m_system.allAtOnce)
+			if (m_particles[t].elapsed > releaseTime || m_system->allAtOnce)
 			{
 				m_particles[t].elapsed = 0.0f;
 				m_particles[t].released = true;
@@ -595,26 +811,26 @@ bool ETHParticleManager::UpdateParticleSystem(const Vector2 &v2Pos, const Vector
 
 		if (m_particles[t].released)
 		{
-			m_particles[t].v2Dir = m_particles[t].v2Dir + (m_system.v2GravityVector*frameSpeed);
+			m_particles[t].v2Dir = m_particles[t].v2Dir + (m_system->v2GravityVector*frameSpeed);
 			m_particles[t].v2Pos = m_particles[t].v2Pos + (m_particles[t].v2Dir*frameSpeed);
 			m_particles[t].angle += (m_particles[t].angleDir*frameSpeed);
-			m_particles[t].size += (m_system.growth*frameSpeed);
+			m_particles[t].size += (m_system->growth*frameSpeed);
 			const float w = m_particles[t].elapsed/m_particles[t].lifeTime;
-			m_particles[t].v4Color = m_system.v4Color0 + (m_system.v4Color1-m_system.v4Color0)*w;
+			m_particles[t].v4Color = m_system->v4Color0 + (m_system->v4Color1-m_system->v4Color0)*w;
 
 			// update particle animation if there is any
-			if (m_system.v2SpriteCut.x > 1 || m_system.v2SpriteCut.y > 1)
+			if (m_system->v2SpriteCut.x > 1 || m_system->v2SpriteCut.y > 1)
 			{
-				if (m_system.animationMode == _ETH_PLAY_ANIMATION)
+				if (m_system->animationMode == _ETH_PLAY_ANIMATION)
 				{
 					m_particles[t].currentFrame = static_cast<unsigned int>(
-						Min(static_cast<int>(static_cast<float>(m_system.GetNumFrames())*w),
-							m_system.GetNumFrames() - 1));
+						Min(static_cast<int>(static_cast<float>(m_system->GetNumFrames())*w),
+							m_system->GetNumFrames() - 1));
 				}
 			}
 
-			m_particles[t].size = Min(m_particles[t].size, m_system.maxSize);
-			m_particles[t].size = Max(m_particles[t].size, m_system.minSize);
+			m_particles[t].size = Min(m_particles[t].size, m_system->maxSize);
+			m_particles[t].size = Max(m_particles[t].size, m_system->minSize);
 
 			if (m_particles[t].elapsed>m_particles[t].lifeTime)
 			{
@@ -625,11 +841,6 @@ bool ETHParticleManager::UpdateParticleSystem(const Vector2 &v2Pos, const Vector
 		}
 	}
 	m_finished = !anythingDrawn;
-
-	// manages the sound
-	HandleSoundPlayback(v2Pos, frameSpeed);
-
-	return true;
 }
 
 void ETHParticleManager::HandleSoundPlayback(const Vector2 &v2Pos, const float frameSpeed)
@@ -637,7 +848,7 @@ void ETHParticleManager::HandleSoundPlayback(const Vector2 &v2Pos, const float f
 	if (!m_pSound)
 		return;
 
-	const Vector2 v2FinalPos = v2Pos+ETHGlobal::ToVector2(m_system.v3StartPoint);
+	const Vector2 v2FinalPos = v2Pos+ETHGlobal::ToVector2(m_system->v3StartPoint);
 	if (m_nActiveParticles <= 0)
 	{
 		if (IsSoundLooping())
@@ -659,14 +870,14 @@ void ETHParticleManager::HandleSoundPlayback(const Vector2 &v2Pos, const float f
 		float volume = 1.0f;
 		if (m_isSoundLooping)
 		{
-			volume = (float)m_nActiveParticles/(float)m_system.nParticles;
+			volume = (float)m_nActiveParticles/(float)m_system->nParticles;
 		}
 		m_pSound->SetVolume(m_soundVolume * volume * m_entityVolume * m_generalVolume);
 
 		// if the particle system is supposed to repeat many times (nRepeat >= N), lets loop
 		// it's sound effect. If it's not, then the application has to take care of it
 		if ((!m_pSound->IsPlaying() || !m_pSound->GetLoop()) &&
-			(m_system.repeat >= _ETH_MINIMUM_PARTICLE_REPEATS_TO_LOOP_SOUND || m_system.repeat <= 0))
+			(m_system->repeat >= _ETH_MINIMUM_PARTICLE_REPEATS_TO_LOOP_SOUND || m_system->repeat <= 0))
 		{
 			m_isSoundLooping = true;
 
@@ -677,7 +888,7 @@ void ETHParticleManager::HandleSoundPlayback(const Vector2 &v2Pos, const float f
 				m_pSound->SetLoop(true);
 			}
 		}
-		if (m_system.repeat < _ETH_MINIMUM_PARTICLE_REPEATS_TO_LOOP_SOUND && m_system.repeat > 0)
+		if (m_system->repeat < _ETH_MINIMUM_PARTICLE_REPEATS_TO_LOOP_SOUND && m_system->repeat > 0)
 			m_isSoundLooping = false;
 
 		m_soundVolume += 0.01f*frameSpeed;
@@ -694,15 +905,22 @@ bool ETHParticleManager::Play(const Vector2 &v2Pos, const Vector3 &v3Pos, const
 {
 	if (m_pSound)
 		m_pSound->Play();
+	ResetParticles(v2Pos, v3Pos, angle);
+	return true;
+}
+
+void ETHParticleManager::ResetParticles(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle)
+{
+	Detach();
 	Matrix4x4 rot = RotateZ(DegreeToRadian(angle));
 	m_finished = false;
-	for (int t=0; t<m_system.nParticles; t++)
+	m_culledElapsedTime = 0;
+	for (int t=0; t<m_system->nParticles; t++)
 	{
 		m_particles[t].repeat = 0;
 		m_particles[t].released = false;
 		ResetParticle(t, v2Pos, v3Pos, angle, rot);
 	}
-	return true;
 }
 
 void ETHParticleManager::BubbleSort(std::vector<ETH_PARTICLE> &v)
@@ -735,51 +953,56 @@ bool ETHParticleManager::DrawParticleSystem(Vector3 v3Ambient, const float maxHe
 	}
 
 	GS_ALPHA_MODE alpha = m_provider->GetVideo()->GetAlphaMode();
-	m_provider->GetVideo()->SetAlphaMode(m_system.alphaMode);
+	m_provider->GetVideo()->SetAlphaMode(m_system->alphaMode);
+
+	// instances draw the shared particles around their own emitter position
+	std::vector<ETH_PARTICLE>& particles = (m_master) ? m_master->m_particles : m_particles;
+	const Vector2 v2Offset = (m_master) ? m_v2InstancePos : Vector2(0,0);
+	const float zOffset = (m_master) ? m_v3InstancePos.z : 0.0f;
 
 	// if the alpha blending is not additive, we'll have to sort it
 	if (alpha == GSAM_PIXEL)
 	{
-		BubbleSort(m_particles);
+		BubbleSort(particles);
 	}
 
 	m_pBMP->SetOrigin(GSEO_CENTER);
-	for (int t=0; t<m_system.nParticles; t++)
+	for (int t=0; t<m_system->nParticles; t++)
 	{
-		if (m_system.repeat>0)
-			if (m_particles[t].repeat >= m_system.repeat)
+		if (m_system->repeat>0)
+			if (particles[t].repeat >= m_system->repeat)
 				continue;
 
-		if (m_particles[t].size <= 0.0f || !m_particles[t].released)
+		if (particles[t].size <= 0.0f || !particles[t].released)
 			continue;
 
-		if (Killed() && m_particles[t].elapsed > m_particles[t].lifeTime)
+		if (Killed() && particles[t].elapsed > particles[t].lifeTime)
 			continue;
 
 		Vector3 v3FinalAmbient(1,1,1);
-		if (m_system.alphaMode == GSAM_PIXEL || m_system.alphaMode == GSAM_ALPHA_TEST)
+		if (m_system->alphaMode == GSAM_PIXEL || m_system->alphaMode == GSAM_ALPHA_TEST)
 		{
-			v3FinalAmbient.x = Min(m_system.emissive.x+v3Ambient.x, 1.0f);
-			v3FinalAmbient.y = Min(m_system.emissive.y+v3Ambient.y, 1.0f);
-			v3FinalAmbient.z = Min(m_system.emissive.z+v3Ambient.z, 1.0f);
+			v3FinalAmbient.x = Min(m_system->emissive.x+v3Ambient.x, 1.0f);
+			v3FinalAmbient.y = Min(m_system->emissive.y+v3Ambient.y, 1.0f);
+			v3FinalAmbient.z = Min(m_system->emissive.z+v3Ambient.z, 1.0f);
 		}
 
 		GS_COLOR dwColor;
-		dwColor.a = (GS_BYTE)(m_particles[t].v4Color.w*255.0f);
-		dwColor.r = (GS_BYTE)(m_particles[t].v4Color.x*v3FinalAmbient.x*255.0f);
-		dwColor.g = (GS_BYTE)(m_particles[t].v4Color.y*v3FinalAmbient.y*255.0f);
-		dwColor.b = (GS_BYTE)(m_particles[t].v4Color.z*v3FinalAmbient.z*255.0f);
+		dwColor.a = (GS_BYTE)(particles[t].v4Color.w*255.0f);
+		dwColor.r = (GS_BYTE)(particles[t].v4Color.x*v3FinalAmbient.x*255.0f);
+		dwColor.g = (GS_BYTE)(particles[t].v4Color.y*v3FinalAmbient.y*255.0f);
+		dwColor.b = (GS_BYTE)(particles[t].v4Color.z*v3FinalAmbient.z*255.0f);
 
 		// compute the right in-screen position
-		const Vector2 v2Pos = ETHGlobal::ToScreenPos(Vector3(m_particles[t].v2Pos, m_system.v3StartPoint.z), zAxisDirection);
+		const Vector2 v2Pos = ETHGlobal::ToScreenPos(Vector3(particles[t].v2Pos + v2Offset, m_system->v3StartPoint.z), zAxisDirection);
 
 		// compute depth
 		if (ownerType != ETH_LAYERABLE)
 		{
-			float offsetYZ = m_particles[t].v3StartPoint.z;
+			float offsetYZ = particles[t].v3StartPoint.z + zOffset;
 			if (ownerType == ETH_VERTICAL)
 			{
-				offsetYZ += m_particles[t].GetOffset() + _ETH_PARTICLE_DEPTH_SHIFT;
+				offsetYZ += particles[t].GetOffset() + _ETH_PARTICLE_DEPTH_SHIFT;
 			}
 			SetParticleDepth(ETHGlobal::ComputeDepth(offsetYZ, maxHeight, minHeight));
 		}
@@ -789,17 +1012,17 @@ bool ETHParticleManager::DrawParticleSystem(Vector3 v3Ambient, const float maxHe
 		}
 
 		// draw
-		if (m_system.v2SpriteCut.x > 1 || m_system.v2SpriteCut.y > 1)
+		if (m_system->v2SpriteCut.x > 1 || m_system->v2SpriteCut.y > 1)
 		{
-			if ((int)m_pBMP->GetNumColumns() != m_system.v2SpriteCut.x || (int)m_pBMP->GetNumRows() != m_system.v2SpriteCut.y)
-				m_pBMP->SetupSpriteRects(m_system.v2SpriteCut.x, m_system.v2SpriteCut.y);
-			m_pBMP->SetRect(m_particles[t].currentFrame);
+			if ((int)m_pBMP->GetNumColumns() != m_system->v2SpriteCut.x || (int)m_pBMP->GetNumRows() != m_system->v2SpriteCut.y)
+				m_pBMP->SetupSpriteRects(m_system->v2SpriteCut.x, m_system->v2SpriteCut.y);
+			m_pBMP->SetRect(particles[t].currentFrame);
 		}
 		else
 		{
 			m_pBMP->UnsetRect();
 		}
-		m_pBMP->DrawOptimal((v2Pos + parallaxOffset), dwColor, m_particles[t].angle, Vector2(m_particles[t].size, m_particles[t].size));
+		m_pBMP->DrawOptimal((v2Pos + parallaxOffset), dwColor, particles[t].angle, Vector2(particles[t].size, particles[t].size));
 	}
 	m_provider->GetVideo()->SetAlphaMode(alpha);
 	return true;
@@ -807,12 +1030,12 @@ bool ETHParticleManager::DrawParticleSystem(Vector3 v3Ambient, const float maxHe
 
 void ETHParticleManager::SetTileZ(const float z)
 {
-	m_system.v3StartPoint.z = z;
+	GetEditableSystem()->v3StartPoint.z = z;
 }
 
 float ETHParticleManager::GetTileZ() const
 {
-	return m_system.v3StartPoint.z;
+	return m_system->v3StartPoint.z;
 }
 
 int ETHParticleManager::GetNumActiveParticles() const
@@ -822,17 +1045,20 @@ int ETHParticleManager::GetNumActiveParticles() const
 
 int ETHParticleManager::GetNumParticles() const
 {
-	return m_system.nParticles;
+	return m_system->nParticles;
 }
 
 bool ETHParticleManager::IsEndless() const
 {
-	return (m_system.repeat == 0);
+	return (m_system->repeat == 0);
 }
 
 void ETHParticleManager::ScaleParticleSystem(const float scale)
 {
-	m_system.Scale(scale);
+	if (scale == 1.0f)
+		return;
+
+	GetEditableSystem()->Scale(scale);
 	for (std::size_t t = 0; t < m_particles.size(); t++)
 	{
 		m_particles[t].Scale(scale);
@@ -841,8 +1067,8 @@ void ETHParticleManager::ScaleParticleSystem(const float scale)
 
 void ETHParticleManager::MirrorX(const bool mirrorGravity)
 {
-	m_system.MirrorX(mirrorGravity);
-	for (int t=0; t<m_system.nParticles; t++)
+	GetEditableSystem()->MirrorX(mirrorGravity);
+	for (int t=0; t<m_system->nParticles; t++)
 	{
 		m_particles[t].v2Dir.x *=-1;
 		m_particles[t].v2Pos.x *=-1;
@@ -851,8 +1077,8 @@ void ETHParticleManager::MirrorX(const bool mirrorGravity)
 
 void ETHParticleManager::MirrorY(const bool mirrorGravity)
 {
-	m_system.MirrorY(mirrorGravity);
-	for (int t=0; t<m_system.nParticles; t++)
+	GetEditableSystem()->MirrorY(mirrorGravity);
+	for (int t=0; t<m_system->nParticles; t++)
 	{
 		m_particles[t].v2Dir.y *=-1;
 		m_particles[t].v2Pos.y *=-1;
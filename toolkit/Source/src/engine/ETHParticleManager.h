@@ -28,6 +28,10 @@
 
 #define _ETH_MINIMUM_PARTICLE_REPEATS_TO_LOOP_SOUND (4)
 #define _ETH_PARTICLE_DEPTH_SHIFT (10.0f)
+#define _ETH_PARTICLE_FAST_FORWARD_STEP (100)
+#define _ETH_PARTICLE_CULLING_MARGIN (64.0f)
+#define _ETH_PARTICLE_CULLED_UPDATE_INTERVAL (500)
+#define _ETH_PARTICLE_INSTANCE_PHASES (4)
 
 #define _ETH_PLAY_ANIMATION 1
 #define _ETH_PICK_RANDOM_FRAME 2
@@ -82,6 +86,7 @@ struct ETH_PARTICLE_SYSTEM
 	str_type::string bitmapFile;
 	str_type::string soundFXFile;
 	ETH_BOOL allAtOnce;
+	ETH_BOOL instanced;
 	float boundingSphere;
 	GS_ALPHA_MODE alphaMode;
 	int nParticles;
@@ -114,6 +119,8 @@ struct ETH_PARTICLE_SYSTEM
 	float randAngleStart;
 };
 
+typedef boost::shared_ptr<ETH_PARTICLE_SYSTEM> ETHParticleSystemPtr;
+
 class ETHParticleManager
 {
 public:
@@ -124,10 +131,28 @@ public:
 	ETHParticleManager(ETHResourceProviderPtr provider, const ETH_PARTICLE_SYSTEM &partSystem, const Vector2 &v2Pos,
 					   const Vector3 &v3Pos, const float angle, const float entityVolume);
 
+	/// Share an already parsed particle system definition. The definition is only
+	/// copied if this manager has to change it (scale, mirror, start position...)
+	ETHParticleManager(ETHResourceProviderPtr provider, const ETHParticleSystemPtr &partSystem, const Vector2 &v2Pos,
+					   const Vector3 &v3Pos, const float angle, const float entityVolume);
+
 	/// Update the position, size and angle of all particles in the system (if they are active)
 	/// Must be called once every frame (only once). The new particles are positioned according
-	/// to v2Pos and it's starting position
-	bool UpdateParticleSystem(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const unsigned long lastFrameElapsedTime);
+	/// to v2Pos and it's starting position. Systems out of the camera view are only simulated
+	/// every _ETH_PARTICLE_CULLED_UPDATE_INTERVAL milliseconds and catch up when they show up again.
+	/// parallaxOffset must be the same offset the system will be drawn with
+	bool UpdateParticleSystem(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const unsigned long lastFrameElapsedTime,
+							  const Vector2 &parallaxOffset);
+
+	/// Simulate 'milliseconds' of the system in steps of 'stepMS' without drawing or playing sounds.
+	/// Useful to prewarm systems that should look as if they had been running for a while.
+	/// Endless systems are never simulated for longer than twice their particles' lifetime
+	void FastForward(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const unsigned long milliseconds,
+					 const unsigned long stepMS = _ETH_PARTICLE_FAST_FORWARD_STEP);
+
+	/// Reseed the emitter random stream and restart all particles from it, so that
+	/// the same seed and the same sequence of updates always produce the same particles
+	void SetRandomSeed(const unsigned int seed, const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle);
 
 	/// Draw all particles also considering it's ambient light color
 	bool DrawParticleSystem(Vector3 v3Ambient, const float maxHeight, const float minHeight,
@@ -162,6 +187,15 @@ public:
 	/// Kill the particle system by avoiding new particles to be launched
 	void Kill(const bool kill);
 
+	/// Return true if this system is being drawn from a simulation shared with other emitters.
+	/// Only endless, non-rotated systems flagged as 'instanced' are shared. Any call that changes
+	/// the system or its playback (Kill, Play, Scale, Mirror...) turns it into an independent system
+	bool IsInstanced() const;
+
+	/// Return true if the bounding sphere of the system, emitted from v2Pos and drawn
+	/// displaced by parallaxOffset, touches the camera view
+	bool IsOnScreen(const Vector2 &v2Pos, const Vector2 &parallaxOffset) const;
+
 	/// Return true if the system was killed by Kill(bool) function
 	inline bool Killed() const
 	{
@@ -221,60 +255,88 @@ public:
 	void MirrorY(const bool mirrorGravity);
 
 private:
-	ETH_PARTICLE_SYSTEM m_system;
+	ETHParticleSystemPtr m_system;
 	std::vector<ETH_PARTICLE> m_particles;
 	ETHResourceProviderPtr m_provider;
 	SpritePtr m_pBMP;
 	AudioSamplePtr m_pSound;
 	bool m_finished, m_killed;
 	int m_nActiveParticles;
+	unsigned long m_culledElapsedTime;
 	Vector2 m_v2Move;
 	float m_soundVolume;
 	bool m_isSoundLooping;
 	bool m_isSoundStopped;
 	float m_entityVolume, m_generalVolume;
+	RandomStream m_random;
+
+	typedef std::pair<const ETH_PARTICLE_SYSTEM*, unsigned int> INSTANCE_KEY;
+	static std::map<INSTANCE_KEY, boost::weak_ptr<ETHParticleManager> > m_instanceMasters;
+	boost::shared_ptr<ETHParticleManager> m_master;
+	bool m_instancingPending;
+	Vector2 m_v2InstancePos;
+	Vector3 m_v3InstancePos;
+	unsigned long m_lastSharedUpdate;
 
 	static void BubbleSort(std::vector<ETH_PARTICLE> &v);
 	void HandleSoundPlayback(const Vector2 &v2Pos, const float frameSpeed);
+	void Simulate(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const unsigned long elapsedTime, const float frameSpeed);
+	void ResetParticles(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle);
+
+	/// Start drawing from the shared simulation of this definition, if it can be instanced
+	bool AttachToMaster(const float angle);
+
+	/// Take a copy of the shared particles and go on simulating them independently
+	void Detach();
+
+	/// Advance a master simulation once per frame, no matter how many instances ask for it
+	void UpdateShared(const unsigned long currentTime);
+
+	/// An endless system doesn't remember anything older than its particles' lifetime,
+	/// so simulating more than this looks the same as simulating exactly this
+	unsigned long GetMaxCatchUpTime() const;
 
 	/// Create a particle system
-	bool CreateParticleSystem(const ETH_PARTICLE_SYSTEM &partSystem, const Vector2 &v2Pos,
+	bool CreateParticleSystem(const ETHParticleSystemPtr &partSystem, const Vector2 &v2Pos,
 							  const Vector3 &v3Pos, const float angle, const float entityVolume);
 
+	/// Return a system definition that is safe to modify, copying the shared one if necessary
+	ETH_PARTICLE_SYSTEM* GetEditableSystem();
+
 	inline void ResetParticle(const int t, const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle, const Matrix4x4 &rotMatrix)
 	{
-		m_particles[t].angleDir = m_system.angleDir + Randomizer::Float(-m_system.randAngle/2, m_system.randAngle/2);
+		m_particles[t].angleDir = m_system->angleDir + m_random.Float(-m_system->randAngle/2, m_system->randAngle/2);
 		m_particles[t].elapsed = 0.0f;
-		m_particles[t].lifeTime = m_system.lifeTime + Randomizer::Float(-m_system.randomizeLifeTime/2, m_system.randomizeLifeTime/2);
-		m_particles[t].size = m_system.size + Randomizer::Float(-m_system.randomizeSize/2, m_system.randomizeSize/2);
-		m_particles[t].v2Dir.x = (m_system.v2DirectionVector.x + Randomizer::Float(-m_system.v2RandomizeDir.x/2, m_system.v2RandomizeDir.x/2));
-		m_particles[t].v2Dir.y = (m_system.v2DirectionVector.y + Randomizer::Float(-m_system.v2RandomizeDir.y/2, m_system.v2RandomizeDir.y/2));
+		m_particles[t].lifeTime = m_system->lifeTime + m_random.Float(-m_system->randomizeLifeTime/2, m_system->randomizeLifeTime/2);
+		m_particles[t].size = m_system->size + m_random.Float(-m_system->randomizeSize/2, m_system->randomizeSize/2);
+		m_particles[t].v2Dir.x = (m_system->v2DirectionVector.x + m_random.Float(-m_system->v2RandomizeDir.x/2, m_system->v2RandomizeDir.x/2));
+		m_particles[t].v2Dir.y = (m_system->v2DirectionVector.y + m_random.Float(-m_system->v2RandomizeDir.y/2, m_system->v2RandomizeDir.y/2));
 		m_particles[t].v2Dir = Multiply(m_particles[t].v2Dir, rotMatrix);
-		m_particles[t].v4Color = m_system.v4Color0;
+		m_particles[t].v4Color = m_system->v4Color0;
 		PositionParticle(t, v2Pos, angle, rotMatrix, v3Pos);
 
 		// setup sprite frame
-		if (m_system.v2SpriteCut.x > 1 || m_system.v2SpriteCut.y > 1)
+		if (m_system->v2SpriteCut.x > 1 || m_system->v2SpriteCut.y > 1)
 		{
-			if (m_system.animationMode == _ETH_PLAY_ANIMATION)
+			if (m_system->animationMode == _ETH_PLAY_ANIMATION)
 			{
 				m_particles[t].currentFrame = 0;
 			} else
-			if (m_system.animationMode == _ETH_PICK_RANDOM_FRAME)
+			if (m_system->animationMode == _ETH_PICK_RANDOM_FRAME)
 			{
-				m_particles[t].currentFrame = Randomizer::Int(m_system.v2SpriteCut.x*m_system.v2SpriteCut.y-1);
+				m_particles[t].currentFrame = m_random.Int(m_system->v2SpriteCut.x*m_system->v2SpriteCut.y-1);
 			}
 		}
 	}
 
 	inline void PositionParticle(const int t, const Vector2 &v2Pos, const float angle, const Matrix4x4 &rotMatrix, const Vector3 &v3Pos)
 	{
-		m_particles[t].angle = m_system.angleStart+Randomizer::Float(m_system.randAngleStart)+angle;
-		m_particles[t].v2Pos.x = m_system.v3StartPoint.x + Randomizer::Float(-m_system.v2RandStartPoint.x/2, m_system.v2RandStartPoint.x/2);
-		m_particles[t].v2Pos.y = m_system.v3StartPoint.y + Randomizer::Float(-m_system.v2RandStartPoint.y/2, m_system.v2RandStartPoint.y/2);
+		m_particles[t].angle = m_system->angleStart+m_random.Float(m_system->randAngleStart)+angle;
+		m_particles[t].v2Pos.x = m_system->v3StartPoint.x + m_random.Float(-m_system->v2RandStartPoint.x/2, m_system->v2RandStartPoint.x/2);
+		m_particles[t].v2Pos.y = m_system->v3StartPoint.y + m_random.Float(-m_system->v2RandStartPoint.y/2, m_system->v2RandStartPoint.y/2);
 		m_particles[t].v2Pos = Multiply(m_particles[t].v2Pos, rotMatrix);	
 		m_particles[t].v2Pos = m_particles[t].v2Pos + v2Pos;
-		m_particles[t].v3StartPoint = Vector3(v2Pos, v3Pos.z)+m_system.v3StartPoint;
+		m_particles[t].v3StartPoint = Vector3(v2Pos, v3Pos.z)+m_system->v3StartPoint;
 	}
 
 	inline void SetParticleDepth(const float depth)
@@ -21,6 +21,9 @@
 --------------------------------------------------------------------------------------*/
 
 #include "ETHCustomDataManager.h"
+#include "../Resource/ETHResourceProvider.h"
+#include <boost/unordered/unordered_map.hpp>
+#include <algorithm>
 #include <iostream>
 
 const str_type::string ETHCustomDataManager::DATA_NAME[ETH_CUSTOM_DATA_TYPE_COUNT] =
@@ -34,332 +37,483 @@ const str_type::string ETHCustomDataManager::DATA_NAME[ETH_CUSTOM_DATA_TYPE_COUN
 	(GS_L("vector3"))
 };
 
-const ETHCustomDataManager& ETHCustomDataManager::operator=(const ETHCustomDataManager& a)
+const unsigned int ETHCustomDataManager::INVALID_KEY = 0xFFFFFFFF;
+
+// kept out of the header so boost's hash isn't dragged into every file that includes it
+struct ETHCustomDataManager::KEY_TABLE
+{
+	boost::unordered_map<str_type::string, unsigned int> keys;
+	std::vector<str_type::string> names;
+};
+
+ETHCustomDataManager::KEY_TABLE& ETHCustomDataManager::GetKeyTable()
 {
-	a.CopyMap(m_data);
-	return a;
+	static KEY_TABLE table;
+	return table;
 }
 
-const str_type::string &ETHCustomDataManager::GetDataName(const unsigned int n)
+unsigned int ETHCustomDataManager::GetKey(const str_type::string &name)
 {
-	assert(n<ETH_CUSTOM_DATA_TYPE_COUNT);
-	return DATA_NAME[n];
+	KEY_TABLE& table = GetKeyTable();
+	boost::unordered_map<str_type::string, unsigned int>::const_iterator iter = table.keys.find(name);
+	if (iter != table.keys.end())
+		return iter->second;
+
+	const unsigned int key = static_cast<unsigned int>(table.names.size());
+	table.names.push_back(name);
+	table.keys[name] = key;
+	return key;
 }
 
-void ETHCustomDataManager::SetFloat(const str_type::string &name, const float &value)
+unsigned int ETHCustomDataManager::FindKey(const str_type::string &name)
 {
-	m_data[name] = ETHCustomDataPtr(new ETHFloatData(value));
+	const KEY_TABLE& table = GetKeyTable();
+	boost::unordered_map<str_type::string, unsigned int>::const_iterator iter = table.keys.find(name);
+	return (iter != table.keys.end()) ? iter->second : INVALID_KEY;
 }
 
-void ETHCustomDataManager::SetInt(const str_type::string &name, const int &value)
+const str_type::string &ETHCustomDataManager::GetKeyName(const unsigned int key)
 {
-	m_data[name] = ETHCustomDataPtr(new ETHIntData(value));
+	const KEY_TABLE& table = GetKeyTable();
+	assert(key < table.names.size());
+	return table.names[key];
 }
 
-void ETHCustomDataManager::SetUInt(const str_type::string &name, const unsigned int &value)
+const ETHCustomDataManager& ETHCustomDataManager::operator=(const ETHCustomDataManager& a)
 {
-	m_data[name] = ETHCustomDataPtr(new ETHUIntData(value));
+	m_entries = a.m_entries;
+	return *this;
 }
 
-void ETHCustomDataManager::SetString(const str_type::string &name, const str_type::string &sValue)
+const str_type::string &ETHCustomDataManager::GetDataName(const unsigned int n)
 {
-	m_data[name] = ETHCustomDataPtr(new ETHStringData(sValue));
+	assert(n<ETH_CUSTOM_DATA_TYPE_COUNT);
+	return DATA_NAME[n];
 }
 
-void ETHCustomDataManager::SetVector2(const str_type::string &name, const Vector2 &v)
+bool ETHCustomDataManager::IsNameLess(const ENTRY* a, const ENTRY* b)
 {
-	m_data[name] = ETHCustomDataPtr(new ETHVector2Data(v));
+	return (GetKeyName(a->key) < GetKeyName(b->key));
 }
 
-void ETHCustomDataManager::SetVector3(const str_type::string &name, const Vector3 &v)
+ETHCustomDataManager::ENTRY* ETHCustomDataManager::Find(const unsigned int key, const ETH_CUSTOM_DATA_TYPE type)
 {
-	m_data[name] = ETHCustomDataPtr(new ETHVector3Data(v));
+	std::vector<ENTRY>::iterator iter = std::lower_bound(m_entries.begin(), m_entries.end(), key, KEY_LESS());
+	if (iter == m_entries.end() || iter->key != key)
+		return 0;
+	if (type != ETHDT_NODATA && iter->type != type)
+		return 0;
+	return &(*iter);
 }
 
-bool ETHCustomDataManager::GetFloat(const str_type::string &name, float &outValue) const
+const ETHCustomDataManager::ENTRY* ETHCustomDataManager::Find(const unsigned int key, const ETH_CUSTOM_DATA_TYPE type) const
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
+	std::vector<ENTRY>::const_iterator iter = std::lower_bound(m_entries.begin(), m_entries.end(), key, KEY_LESS());
+	if (iter == m_entries.end() || iter->key != key)
+		return 0;
+	if (type != ETHDT_NODATA && iter->type != type)
+		return 0;
+	return &(*iter);
+}
+
+ETHCustomDataManager::ENTRY* ETHCustomDataManager::Insert(const unsigned int key, const ETH_CUSTOM_DATA_TYPE type)
+{
+	// scripts may pass any number as a key, but only the ones GetKey has issued have a name
+	if (key >= GetKeyTable().names.size())
 	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return false;
+		ETH_STREAM_DECL(ss) << GS_L("Custom data: invalid key (") << key << GS_L(")");
+		ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
+		return 0;
 	}
-	if (iter->second->GetType() != ETHDT_FLOAT)
+
+	std::vector<ENTRY>::iterator iter = std::lower_bound(m_entries.begin(), m_entries.end(), key, KEY_LESS());
+	if (iter == m_entries.end() || iter->key != key)
 	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a float");
-		return false;
+		ENTRY entry;
+		entry.key = key;
+		iter = m_entries.insert(iter, entry);
 	}
-	outValue = iter->second->GetFloat();
-	return true;
+	else if (iter->type == ETHDT_STRING && type != ETHDT_STRING)
+	{
+		str_type::string().swap(iter->str);
+	}
+	iter->type = type;
+	return &(*iter);
 }
 
-bool ETHCustomDataManager::GetInt(const str_type::string &name, int &outValue) const
+void ETHCustomDataManager::GetEntriesSortedByName(std::vector<const ENTRY*>& entries) const
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
+	entries.resize(m_entries.size());
+	for (std::size_t t = 0; t < m_entries.size(); t++)
 	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return false;
+		entries[t] = &m_entries[t];
 	}
-	if (iter->second->GetType() != ETHDT_INT)
+	std::sort(entries.begin(), entries.end(), IsNameLess);
+}
+
+str_type::string ETHCustomDataManager::GetValueAsString(const ENTRY& entry)
+{
+	str_type::stringstream ss;
+	switch (entry.type)
 	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not an int");
-		return false;
-	}
-	outValue = iter->second->GetInt();
-	return true;
+	case ETHDT_FLOAT:
+		ss << entry.f;
+		break;
+	case ETHDT_INT:
+		ss << entry.i;
+		break;
+	case ETHDT_UINT:
+		ss << entry.u;
+		break;
+	case ETHDT_STRING:
+		ss << entry.str;
+		break;
+	case ETHDT_VECTOR2:
+		ss << "(" << entry.v[0] << ", " << entry.v[1] << ")";
+		break;
+	case ETHDT_VECTOR3:
+		ss << "(" << entry.v[0] << ", " << entry.v[1] << ", " << entry.v[2] << ")";
+		break;
+	default:
+		break;
+	};
+	return ss.str();
 }
 
-bool ETHCustomDataManager::GetUInt(const str_type::string &name, unsigned int &outValue) const
+void ETHCustomDataManager::SetFloat(const unsigned int key, const float value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
+	ENTRY* entry = Insert(key, ETHDT_FLOAT);
+	if (entry)
+		entry->f = value;
+}
+
+void ETHCustomDataManager::SetInt(const unsigned int key, const int value)
+{
+	ENTRY* entry = Insert(key, ETHDT_INT);
+	if (entry)
+		entry->i = value;
+}
+
+void ETHCustomDataManager::SetUInt(const unsigned int key, const unsigned int value)
+{
+	ENTRY* entry = Insert(key, ETHDT_UINT);
+	if (entry)
+		entry->u = value;
+}
+
+void ETHCustomDataManager::SetString(const unsigned int key, const str_type::string &sValue)
+{
+	ENTRY* entry = Insert(key, ETHDT_STRING);
+	if (entry)
+		entry->str = sValue;
+}
+
+void ETHCustomDataManager::SetVector2(const unsigned int key, const Vector2 &v)
+{
+	ENTRY* entry = Insert(key, ETHDT_VECTOR2);
+	if (entry)
 	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return false;
+		entry->v[0] = v.x;
+		entry->v[1] = v.y;
 	}
-	if (iter->second->GetType() != ETHDT_UINT)
+}
+
+void ETHCustomDataManager::SetVector3(const unsigned int key, const Vector3 &v)
+{
+	ENTRY* entry = Insert(key, ETHDT_VECTOR3);
+	if (entry)
 	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not an uint");
-		return false;
+		entry->v[0] = v.x;
+		entry->v[1] = v.y;
+		entry->v[2] = v.z;
 	}
-	outValue = iter->second->GetUInt();
-	return true;
 }
 
-bool ETHCustomDataManager::GetString(const str_type::string &name, str_type::string &outValue) const
+bool ETHCustomDataManager::GetFloat(const unsigned int key, float &outValue) const
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
+	const ENTRY* entry = Find(key, ETHDT_FLOAT);
+	if (!entry)
 		return false;
-	}
-	if (iter->second->GetType() != ETHDT_STRING)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a string");
+	outValue = entry->f;
+	return true;
+}
+
+bool ETHCustomDataManager::GetInt(const unsigned int key, int &outValue) const
+{
+	const ENTRY* entry = Find(key, ETHDT_INT);
+	if (!entry)
 		return false;
-	}
-	outValue = iter->second->GetString();
+	outValue = entry->i;
 	return true;
 }
 
-bool ETHCustomDataManager::GetVector2(const str_type::string &name, Vector2 &outValue) const
+bool ETHCustomDataManager::GetUInt(const unsigned int key, unsigned int &outValue) const
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
+	const ENTRY* entry = Find(key, ETHDT_UINT);
+	if (!entry)
 		return false;
-	}
-	if (iter->second->GetType() != ETHDT_VECTOR2)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a vector2");
+	outValue = entry->u;
+	return true;
+}
+
+bool ETHCustomDataManager::GetString(const unsigned int key, str_type::string &outValue) const
+{
+	const ENTRY* entry = Find(key, ETHDT_STRING);
+	if (!entry)
 		return false;
-	}
-	outValue = iter->second->GetVector2();
+	outValue = entry->str;
 	return true;
 }
 
-bool ETHCustomDataManager::GetVector3(const str_type::string &name, Vector3 &outValue) const
+bool ETHCustomDataManager::GetVector2(const unsigned int key, Vector2 &outValue) const
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
+	const ENTRY* entry = Find(key, ETHDT_VECTOR2);
+	if (!entry)
 		return false;
-	}
-	if (iter->second->GetType() != ETHDT_VECTOR3)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a vector3");
+	outValue = Vector2(entry->v[0], entry->v[1]);
+	return true;
+}
+
+bool ETHCustomDataManager::GetVector3(const unsigned int key, Vector3 &outValue) const
+{
+	const ENTRY* entry = Find(key, ETHDT_VECTOR3);
+	if (!entry)
 		return false;
-	}
-	outValue = iter->second->GetVector3();
+	outValue = Vector3(entry->v[0], entry->v[1], entry->v[2]);
 	return true;
 }
 
-void ETHCustomDataManager::AddToFloat(const str_type::string &name, const float &value)
+void ETHCustomDataManager::AddToFloat(const unsigned int key, const float value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
+	ENTRY* entry = Find(key, ETHDT_FLOAT);
+	if (entry)
+		entry->f += value;
+}
+
+void ETHCustomDataManager::AddToInt(const unsigned int key, const int value)
+{
+	ENTRY* entry = Find(key, ETHDT_INT);
+	if (entry)
+		entry->i += value;
+}
+
+void ETHCustomDataManager::AddToUInt(const unsigned int key, const unsigned int value)
+{
+	ENTRY* entry = Find(key, ETHDT_UINT);
+	if (entry)
+		entry->u += value;
+}
+
+void ETHCustomDataManager::AddToVector2(const unsigned int key, const Vector2 &v)
+{
+	ENTRY* entry = Find(key, ETHDT_VECTOR2);
+	if (entry)
 	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
+		entry->v[0] += v.x;
+		entry->v[1] += v.y;
 	}
-	if (iter->second->GetType() != ETHDT_FLOAT)
+}
+
+void ETHCustomDataManager::AddToVector3(const unsigned int key, const Vector3 &v)
+{
+	ENTRY* entry = Find(key, ETHDT_VECTOR3);
+	if (entry)
 	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a float");
-		return;
+		entry->v[0] += v.x;
+		entry->v[1] += v.y;
+		entry->v[2] += v.z;
 	}
-	iter->second->Set(value+iter->second->GetFloat());
 }
 
-void ETHCustomDataManager::AddToInt(const str_type::string &name, const int &value)
+void ETHCustomDataManager::MultiplyFloat(const unsigned int key, const float value)
+{
+	ENTRY* entry = Find(key, ETHDT_FLOAT);
+	if (entry)
+		entry->f *= value;
+}
+
+void ETHCustomDataManager::MultiplyInt(const unsigned int key, const int value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
+	ENTRY* entry = Find(key, ETHDT_INT);
+	if (entry)
+		entry->i *= value;
+}
+
+void ETHCustomDataManager::MultiplyUInt(const unsigned int key, const unsigned int value)
+{
+	ENTRY* entry = Find(key, ETHDT_UINT);
+	if (entry)
+		entry->u *= value;
+}
+
+void ETHCustomDataManager::MultiplyVector2(const unsigned int key, const float value)
+{
+	ENTRY* entry = Find(key, ETHDT_VECTOR2);
+	if (entry)
 	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
+		entry->v[0] *= value;
+		entry->v[1] *= value;
 	}
-	if (iter->second->GetType() != ETHDT_INT)
+}
+
+void ETHCustomDataManager::MultiplyVector3(const unsigned int key, const float value)
+{
+	ENTRY* entry = Find(key, ETHDT_VECTOR3);
+	if (entry)
 	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not an int");
-		return;
+		entry->v[0] *= value;
+		entry->v[1] *= value;
+		entry->v[2] *= value;
 	}
-	iter->second->Set(value+iter->second->GetInt());
+}
+
+ETH_CUSTOM_DATA_TYPE ETHCustomDataManager::Check(const unsigned int key) const
+{
+	const ENTRY* entry = Find(key, ETHDT_NODATA);
+	return (entry) ? entry->type : ETHDT_NODATA;
+}
+
+bool ETHCustomDataManager::EraseData(const unsigned int key)
+{
+	std::vector<ENTRY>::iterator iter = std::lower_bound(m_entries.begin(), m_entries.end(), key, KEY_LESS());
+	if (iter == m_entries.end() || iter->key != key)
+		return false;
+	m_entries.erase(iter);
+	return true;
+}
+
+void ETHCustomDataManager::SetFloat(const str_type::string &name, const float &value)
+{
+	SetFloat(GetKey(name), value);
+}
+
+void ETHCustomDataManager::SetInt(const str_type::string &name, const int &value)
+{
+	SetInt(GetKey(name), value);
+}
+
+void ETHCustomDataManager::SetUInt(const str_type::string &name, const unsigned int &value)
+{
+	SetUInt(GetKey(name), value);
+}
+
+void ETHCustomDataManager::SetString(const str_type::string &name, const str_type::string &sValue)
+{
+	SetString(GetKey(name), sValue);
+}
+
+void ETHCustomDataManager::SetVector2(const str_type::string &name, const Vector2 &v)
+{
+	SetVector2(GetKey(name), v);
+}
+
+void ETHCustomDataManager::SetVector3(const str_type::string &name, const Vector3 &v)
+{
+	SetVector3(GetKey(name), v);
+}
+
+bool ETHCustomDataManager::GetFloat(const str_type::string &name, float &outValue) const
+{
+	return GetFloat(FindKey(name), outValue);
+}
+
+bool ETHCustomDataManager::GetInt(const str_type::string &name, int &outValue) const
+{
+	return GetInt(FindKey(name), outValue);
+}
+
+bool ETHCustomDataManager::GetUInt(const str_type::string &name, unsigned int &outValue) const
+{
+	return GetUInt(FindKey(name), outValue);
+}
+
+bool ETHCustomDataManager::GetString(const str_type::string &name, str_type::string &outValue) const
+{
+	return GetString(FindKey(name), outValue);
+}
+
+bool ETHCustomDataManager::GetVector2(const str_type::string &name, Vector2 &outValue) const
+{
+	return GetVector2(FindKey(name), outValue);
+}
+
+bool ETHCustomDataManager::GetVector3(const str_type::string &name, Vector3 &outValue) const
+{
+	return GetVector3(FindKey(name), outValue);
+}
+
+void ETHCustomDataManager::AddToFloat(const str_type::string &name, const float &value)
+{
+	AddToFloat(FindKey(name), value);
+}
+
+void ETHCustomDataManager::AddToInt(const str_type::string &name, const int &value)
+{
+	AddToInt(FindKey(name), value);
 }
 
 void ETHCustomDataManager::AddToUInt(const str_type::string &name, const unsigned int &value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
-	}
-	if (iter->second->GetType() != ETHDT_UINT)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not an uint");
-		return;
-	}
-	iter->second->Set(value+iter->second->GetUInt());
+	AddToUInt(FindKey(name), value);
 }
 
 void ETHCustomDataManager::AddToVector2(const str_type::string &name, const Vector2 &v)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
-	}
-	if (iter->second->GetType() != ETHDT_VECTOR2)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a vector2");
-		return;
-	}
-	iter->second->Set(v+iter->second->GetVector2());
+	AddToVector2(FindKey(name), v);
 }
 
 void ETHCustomDataManager::AddToVector3(const str_type::string &name, const Vector3 &v)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
-	}
-	if (iter->second->GetType() != ETHDT_VECTOR3)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a vector3");
-		return;
-	}
-	iter->second->Set(v+iter->second->GetVector3());
+	AddToVector3(FindKey(name), v);
 }
 
 void ETHCustomDataManager::MultiplyFloat(const str_type::string &name, const float &value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
-	}
-	if (iter->second->GetType() != ETHDT_FLOAT)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a float");
-		return;
-	}
-	iter->second->Set(value*iter->second->GetFloat());
+	MultiplyFloat(FindKey(name), value);
 }
 
 void ETHCustomDataManager::MultiplyInt(const str_type::string &name, const int &value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
-	}
-	if (iter->second->GetType() != ETHDT_INT)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not an int");
-		return;
-	}
-	iter->second->Set(value*iter->second->GetInt());
+	MultiplyInt(FindKey(name), value);
 }
 
 void ETHCustomDataManager::MultiplyUInt(const str_type::string &name, const unsigned int &value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
-	}
-	if (iter->second->GetType() != ETHDT_UINT)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not an uint");
-		return;
-	}
-	iter->second->Set(value*iter->second->GetUInt());
+	MultiplyUInt(FindKey(name), value);
 }
 
 void ETHCustomDataManager::MultiplyVector2(const str_type::string &name, const float &value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
-	}
-	if (iter->second->GetType() != ETHDT_VECTOR2)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a vector2");
-		return;
-	}
-	iter->second->Set(iter->second->GetVector2()*value);
+	MultiplyVector2(FindKey(name), value);
 }
 
 void ETHCustomDataManager::MultiplyVector3(const str_type::string &name, const float &value)
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
-	{
-		ETH_STREAM_DECL(ss) << GS_L("There's no matching data for ") << name;
-		return;
-	}
-	if (iter->second->GetType() != ETHDT_VECTOR3)
-	{
-		ETH_STREAM_DECL(ss) << name << GS_L(":is not a vector3");
-		return;
-	}
-	iter->second->Set(iter->second->GetVector3()*value);
+	MultiplyVector3(FindKey(name), value);
 }
 
 ETH_CUSTOM_DATA_TYPE ETHCustomDataManager::Check(const str_type::string &name) const
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter != m_data.end())
-	{
-		return iter->second->GetType();
-	}
-	else
-	{
-		return ETHDT_NODATA;
-	}
+	return Check(FindKey(name));
+}
+
+bool ETHCustomDataManager::EraseData(const str_type::string &name)
+{
+	return EraseData(FindKey(name));
 }
 
 str_type::string ETHCustomDataManager::GetDebugStringData() const
 {
-	if (!m_data.empty())
+	if (!m_entries.empty())
 	{
+		std::vector<const ENTRY*> entries;
+		GetEntriesSortedByName(entries);
+
 		str_type::stringstream ss;
-		for (std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.begin(); iter != m_data.end(); iter++)
+		for (std::size_t t = 0; t < entries.size(); t++)
 		{
-			ss << DATA_NAME[iter->second->GetType()] << GS_L(" ") << iter->first
-				<< GS_L(" = ") << iter->second->GetValueAsString() << std::endl;
+			ss << DATA_NAME[entries[t]->type] << GS_L(" ") << GetKeyName(entries[t]->key)
+				<< GS_L(" = ") << GetValueAsString(*entries[t]) << std::endl;
 		}
 		return ss.str();
 	}
@@ -371,76 +525,58 @@ str_type::string ETHCustomDataManager::GetDebugStringData() const
 
 bool ETHCustomDataManager::HasData() const
 {
-	return (m_data.size()>0);
-}
-
-bool ETHCustomDataManager::EraseData(const str_type::string &name)
-{
-	std::map<str_type::string, ETHCustomDataPtr>::iterator iter = m_data.find(name);
-	if (iter != m_data.end())
-	{
-		m_data.erase(iter);
-	}
-	else
-	{
-		return false;
-	}
-	return true;
+	return !m_entries.empty();
 }
 
 unsigned int ETHCustomDataManager::GetNumVariables() const
 {
-	return m_data.size();
+	return static_cast<unsigned int>(m_entries.size());
 }
 
 void ETHCustomDataManager::Clear()
 {
-	m_data.clear();
+	m_entries.clear();
 }
 
 void ETHCustomDataManager::MoveData(ETHCustomDataManager &dataOut) const
 {
-	
-	for (std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.begin();
-		 iter != m_data.end(); iter++)
-	{
-		dataOut.AddData(iter->first, iter->second);
-	}
+	dataOut.InsertData(*this);
 }
 
 void ETHCustomDataManager::InsertData(const ETHCustomDataManager &dataIn)
 {
-	for (std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = dataIn.m_data.begin();
-		 iter != dataIn.m_data.end(); iter++)
+	for (std::vector<ENTRY>::const_iterator iter = dataIn.m_entries.begin(); iter != dataIn.m_entries.end(); ++iter)
 	{
-		AddData(iter->first, iter->second);
+		// keys that made it into another manager have already been validated
+		*Insert(iter->key, iter->type) = *iter;
 	}
 }
 
 void ETHCustomDataManager::CopyMap(std::map<str_type::string, ETHCustomDataPtr> &inMap) const
 {
 	inMap.clear();
-	for (std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.begin(); iter != m_data.end(); iter++)
+	for (std::vector<ENTRY>::const_iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
 	{
-		switch (iter->second->GetType())
+		const str_type::string& name = GetKeyName(iter->key);
+		switch (iter->type)
 		{
 		case ETHDT_FLOAT:
-			inMap[iter->first] = ETHCustomDataPtr(new ETHFloatData(iter->second->GetFloat()));
+			inMap[name] = ETHCustomDataPtr(new ETHFloatData(iter->f));
 			break;
 		case ETHDT_INT:
-			inMap[iter->first] = ETHCustomDataPtr(new ETHIntData(iter->second->GetInt()));
+			inMap[name] = ETHCustomDataPtr(new ETHIntData(iter->i));
 			break;
 		case ETHDT_UINT:
-			inMap[iter->first] = ETHCustomDataPtr(new ETHUIntData(iter->second->GetUInt()));
+			inMap[name] = ETHCustomDataPtr(new ETHUIntData(iter->u));
 			break;
 		case ETHDT_STRING:
-			inMap[iter->first] = ETHCustomDataPtr(new ETHStringData(iter->second->GetString()));
+			inMap[name] = ETHCustomDataPtr(new ETHStringData(iter->str));
 			break;
 		case ETHDT_VECTOR2:
-			inMap[iter->first] = ETHCustomDataPtr(new ETHVector2Data(iter->second->GetVector2()));
+			inMap[name] = ETHCustomDataPtr(new ETHVector2Data(Vector2(iter->v[0], iter->v[1])));
 			break;
 		case ETHDT_VECTOR3:
-			inMap[iter->first] = ETHCustomDataPtr(new ETHVector3Data(iter->second->GetVector3()));
+			inMap[name] = ETHCustomDataPtr(new ETHVector3Data(Vector3(iter->v[0], iter->v[1], iter->v[2])));
 			break;
 		default:
 			break;
@@ -453,22 +589,22 @@ void ETHCustomDataManager::AddData(const str_type::string &name, const ETHCustom
 	switch (dataIn->GetType())
 	{
 		case ETHDT_FLOAT:
-			m_data[name] = ETHCustomDataPtr(new ETHFloatData(dataIn->GetFloat()));
+			SetFloat(name, dataIn->GetFloat());
 			break;
 		case ETHDT_INT:
-			m_data[name] = ETHCustomDataPtr(new ETHIntData(dataIn->GetInt()));
+			SetInt(name, dataIn->GetInt());
 			break;
 		case ETHDT_UINT:
-			m_data[name] = ETHCustomDataPtr(new ETHUIntData(dataIn->GetUInt()));
+			SetUInt(name, dataIn->GetUInt());
 			break;
 		case ETHDT_STRING:
-			m_data[name] = ETHCustomDataPtr(new ETHStringData(dataIn->GetString()));
+			SetString(name, dataIn->GetString());
 			break;
 		case ETHDT_VECTOR2:
-			m_data[name] = ETHCustomDataPtr(new ETHVector2Data(dataIn->GetVector2()));
+			SetVector2(name, dataIn->GetVector2());
 			break;
 		case ETHDT_VECTOR3:
-			m_data[name] = ETHCustomDataPtr(new ETHVector3Data(dataIn->GetVector3()));
+			SetVector3(name, dataIn->GetVector3());
 			break;
 		default:
 			break;
@@ -477,14 +613,14 @@ void ETHCustomDataManager::AddData(const str_type::string &name, const ETHCustom
 
 str_type::string ETHCustomDataManager::GetValueAsString(const str_type::string &name) const
 {
-	std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.find(name);
-	if (iter == m_data.end())
+	const ENTRY* entry = Find(FindKey(name), ETHDT_NODATA);
+	if (!entry)
 	{
 		return GS_L("");
 	}
 	else
 	{
-		return iter->second->GetValueAsString();
+		return GetValueAsString(*entry);
 	}
 }
 
@@ -592,58 +728,42 @@ bool ETHCustomDataManager::WriteDataToFile(TiXmlElement *pHeadRoot) const
 {
 	TiXmlElement *pCustomData = new TiXmlElement(GS_L("CustomData"));
 	pHeadRoot->LinkEndChild(pCustomData);
-	for (std::map<str_type::string, ETHCustomDataPtr>::const_iterator iter = m_data.begin();
-		iter != m_data.end(); iter++)
+
+	// keep the file in name order so it doesn't depend on when each key was created
+	std::vector<const ENTRY*> entries;
+	GetEntriesSortedByName(entries);
+	for (std::size_t t = 0; t < entries.size(); t++)
 	{
+		const ENTRY& entry = *entries[t];
 		TiXmlElement *pVariableRoot = new TiXmlElement(GS_L("Variable"));
 		pCustomData->LinkEndChild(pVariableRoot); 
 
 		TiXmlElement *pElement;
 		pElement = new TiXmlElement(GS_L("Type"));
-		pElement->LinkEndChild(new TiXmlText(DATA_NAME[iter->second->GetType()] ));
+		pElement->LinkEndChild(new TiXmlText(DATA_NAME[entry.type] ));
 		pVariableRoot->LinkEndChild(pElement);
 
 		pElement = new TiXmlElement(GS_L("Name"));
-		pElement->LinkEndChild(new TiXmlText(iter->first));
+		pElement->LinkEndChild(new TiXmlText(GetKeyName(entry.key)));
 		pVariableRoot->LinkEndChild(pElement);
 
 		pElement = new TiXmlElement(GS_L("Value"));
-
-		str_type::stringstream ss;
-		switch (iter->second->GetType())
-		{
-		case ETHDT_FLOAT:
-			ss << iter->second->GetFloat();
-			break;
-		case ETHDT_INT:
-			ss << iter->second->GetInt();
-			break;
-		case ETHDT_UINT:
-			ss << iter->second->GetUInt();
-			break;
-		case ETHDT_STRING:
-			ss << iter->second->GetString();
-			break;
-		default:
-			break;
-		};
-
-		switch (iter->second->GetType())
+		switch (entry.type)
 		{
 		case ETHDT_FLOAT:
 		case ETHDT_INT:
 		case ETHDT_UINT:
 		case ETHDT_STRING:
-			pElement->LinkEndChild(new TiXmlText(ss.str()));
+			pElement->LinkEndChild(new TiXmlText(GetValueAsString(entry)));
 			break;
 		case ETHDT_VECTOR2:
-			pElement->SetDoubleAttribute(GS_L("x"), iter->second->GetVector2().x);
-			pElement->SetDoubleAttribute(GS_L("y"), iter->second->GetVector2().y);
+			pElement->SetDoubleAttribute(GS_L("x"), entry.v[0]);
+			pElement->SetDoubleAttribute(GS_L("y"), entry.v[1]);
 			break;
 		case ETHDT_VECTOR3:
-			pElement->SetDoubleAttribute(GS_L("x"), iter->second->GetVector3().x);
-			pElement->SetDoubleAttribute(GS_L("y"), iter->second->GetVector3().y);
-			pElement->SetDoubleAttribute(GS_L("z"), iter->second->GetVector3().z);
+			pElement->SetDoubleAttribute(GS_L("x"), entry.v[0]);
+			pElement->SetDoubleAttribute(GS_L("y"), entry.v[1]);
+			pElement->SetDoubleAttribute(GS_L("z"), entry.v[2]);
 			break;
 		default:
 			break;
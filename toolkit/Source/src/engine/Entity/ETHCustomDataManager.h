@@ -25,6 +25,7 @@
 
 #include "../ETHCommon.h"
 #include <map>
+#include <vector>
 #include <string>
 
 enum ETH_CUSTOM_DATA_TYPE
@@ -120,11 +121,57 @@ public: inline ETHVector3Data(const Vector3 &v) { this->v = v; }
 		inline str_type::string GetValueAsString() const { str_type::stringstream ss; ss << "(" << v.x << ", " << v.y << ", " << v.z << ")"; return ss.str(); }
 };
 
+/// Stores entity custom data in a small vector sorted by key. Names are interned into global
+/// numeric keys, and numeric and vector values are kept inline, so reading or writing them doesn't
+/// allocate. Scripts may fetch the key of a name once and pass it instead of the name in hot loops
 class ETHCustomDataManager
 {
 	static const str_type::string DATA_NAME[ETH_CUSTOM_DATA_TYPE_COUNT];
 
+	struct ENTRY
+	{
+		unsigned int key;
+		ETH_CUSTOM_DATA_TYPE type;
+		union
+		{
+			float f;
+			int i;
+			unsigned int u;
+			float v[3];
+		};
+		str_type::string str;
+	};
+
+	struct KEY_TABLE;
+	static KEY_TABLE& GetKeyTable();
+
+	// mixed comparisons for binary searching entries by key
+	struct KEY_LESS
+	{
+		bool operator()(const ENTRY& a, const ENTRY& b) const { return a.key < b.key; }
+		bool operator()(const ENTRY& entry, const unsigned int key) const { return entry.key < key; }
+		bool operator()(const unsigned int key, const ENTRY& entry) const { return key < entry.key; }
+	};
+
+	static bool IsNameLess(const ENTRY* a, const ENTRY* b);
+	static str_type::string GetValueAsString(const ENTRY& entry);
+
+	ENTRY* Find(const unsigned int key, const ETH_CUSTOM_DATA_TYPE type);
+	const ENTRY* Find(const unsigned int key, const ETH_CUSTOM_DATA_TYPE type) const;
+	/// Returns 0 if the key wasn't issued by GetKey
+	ENTRY* Insert(const unsigned int key, const ETH_CUSTOM_DATA_TYPE type);
+	void GetEntriesSortedByName(std::vector<const ENTRY*>& entries) const;
+
 public:
+	static const unsigned int INVALID_KEY;
+
+	/// Returns the key that represents name, creating one if it doesn't exist yet
+	static unsigned int GetKey(const str_type::string &name);
+
+	/// Returns the key that represents name, or INVALID_KEY if no data has ever been named like that
+	static unsigned int FindKey(const str_type::string &name);
+	static const str_type::string &GetKeyName(const unsigned int key);
+
 	str_type::string GetDebugStringData() const;
 	static const str_type::string &GetDataName(const unsigned int n);
 
@@ -159,8 +206,38 @@ public:
 	void MultiplyVector3(const str_type::string &name, const float &value);
 
 	ETH_CUSTOM_DATA_TYPE Check(const str_type::string &name) const;
-	bool HasData() const;
 	bool EraseData(const str_type::string &name);
+
+	void SetFloat(const unsigned int key, const float value);
+	void SetInt(const unsigned int key, const int value);
+	void SetUInt(const unsigned int key, const unsigned int value);
+	void SetString(const unsigned int key, const str_type::string &sValue);
+	void SetVector2(const unsigned int key, const Vector2 &v);
+	void SetVector3(const unsigned int key, const Vector3 &v);
+
+	bool GetFloat(const unsigned int key, float &outValue) const;
+	bool GetInt(const unsigned int key, int &outValue) const;
+	bool GetUInt(const unsigned int key, unsigned int &outValue) const;
+	bool GetString(const unsigned int key, str_type::string &outValue) const;
+	bool GetVector2(const unsigned int key, Vector2 &outValue) const;
+	bool GetVector3(const unsigned int key, Vector3 &outValue) const;
+
+	void AddToFloat(const unsigned int key, const float value);
+	void AddToInt(const unsigned int key, const int value);
+	void AddToUInt(const unsigned int key, const unsigned int value);
+	void AddToVector2(const unsigned int key, const Vector2 &v);
+	void AddToVector3(const unsigned int key, const Vector3 &v);
+
+	void MultiplyFloat(const unsigned int key, const float value);
+	void MultiplyInt(const unsigned int key, const int value);
+	void MultiplyUInt(const unsigned int key, const unsigned int value);
+	void MultiplyVector2(const unsigned int key, const float value);
+	void MultiplyVector3(const unsigned int key, const float value);
+
+	ETH_CUSTOM_DATA_TYPE Check(const unsigned int key) const;
+	bool EraseData(const unsigned int key);
+
+	bool HasData() const;
 	unsigned int GetNumVariables() const;
 	void Clear();
 
@@ -173,7 +250,7 @@ public:
 	bool WriteDataToFile(TiXmlElement *pHeadRoot) const;
 
 private:
-	std::map<str_type::string, ETHCustomDataPtr> m_data;
+	std::vector<ENTRY> m_entries;
 };
 
 #endif
\ No newline at end of file
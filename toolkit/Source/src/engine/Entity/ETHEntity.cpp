@@ -472,7 +472,12 @@ Vector2 ETHEntity::GetScale() const
 void ETHEntity::ScaleParticleSystemOrigin(const unsigned int n, const float scale)
 {
 	if (m_properties.particleSystems[n])
-		m_properties.particleSystems[n]->Scale(scale);
+	{
+		// the definition is shared with other entities, so we scale a copy
+		ETHParticleSystemPtr system(new ETH_PARTICLE_SYSTEM(*m_properties.particleSystems[n]));
+		system->Scale(scale);
+		m_properties.particleSystems[n] = system;
+	}
 }
 
 bool ETHEntity::IsRotatable() const
@@ -823,6 +828,138 @@ bool ETHEntity::EraseData(const str_type::string &name)
 	return m_properties.EraseData(name);
 }
 
+void ETHEntity::SetFloat(const unsigned int key, const float value)
+{
+	m_properties.SetFloat(key, value);
+}
+
+void ETHEntity::SetInt(const unsigned int key, const int value)
+{
+	m_properties.SetInt(key, value);
+}
+
+void ETHEntity::SetUInt(const unsigned int key, const unsigned int value)
+{
+	m_properties.SetUInt(key, value);
+}
+
+void ETHEntity::SetString(const unsigned int key, const str_type::string &value)
+{
+	m_properties.SetString(key, value);
+}
+
+void ETHEntity::SetVector2(const unsigned int key, const Vector2 &value)
+{
+	m_properties.SetVector2(key, value);
+}
+
+void ETHEntity::SetVector3(const unsigned int key, const Vector3 &value)
+{
+	m_properties.SetVector3(key, value);
+}
+
+float ETHEntity::GetFloat(const unsigned int key) const
+{
+	float out = 0.0f;
+	m_properties.GetFloat(key, out);
+	return out;
+}
+
+int ETHEntity::GetInt(const unsigned int key) const
+{
+	int out = 0;
+	m_properties.GetInt(key, out);
+	return out;
+}
+
+unsigned int ETHEntity::GetUInt(const unsigned int key) const
+{
+	unsigned int out = 0;
+	m_properties.GetUInt(key, out);
+	return out;
+}
+
+str_type::string ETHEntity::GetString(const unsigned int key) const
+{
+	str_type::string out = GS_L("");
+	m_properties.GetString(key, out);
+	return out;
+}
+
+Vector2 ETHEntity::GetVector2(const unsigned int key) const
+{
+	Vector2 out = Vector2(0,0);
+	m_properties.GetVector2(key, out);
+	return out;
+}
+
+Vector3 ETHEntity::GetVector3(const unsigned int key) const
+{
+	Vector3 out = Vector3(0,0,0);
+	m_properties.GetVector3(key, out);
+	return out;
+}
+
+void ETHEntity::AddToFloat(const unsigned int key, const float value)
+{
+	m_properties.AddToFloat(key, value);
+}
+
+void ETHEntity::AddToInt(const unsigned int key, const int value)
+{
+	m_properties.AddToInt(key, value);
+}
+
+void ETHEntity::AddToUInt(const unsigned int key, const unsigned int value)
+{
+	m_properties.AddToUInt(key, value);
+}
+
+void ETHEntity::AddToVector2(const unsigned int key, const Vector2 &v)
+{
+	m_properties.AddToVector2(key, v);
+}
+
+void ETHEntity::AddToVector3(const unsigned int key, const Vector3 &v)
+{
+	m_properties.AddToVector3(key, v);
+}
+
+void ETHEntity::MultiplyFloat(const unsigned int key, const float value)
+{
+	m_properties.MultiplyFloat(key, value);
+}
+
+void ETHEntity::MultiplyInt(const unsigned int key, const int value)
+{
+	m_properties.MultiplyInt(key, value);
+}
+
+void ETHEntity::MultiplyUInt(const unsigned int key, const unsigned int value)
+{
+	m_properties.MultiplyUInt(key, value);
+}
+
+void ETHEntity::MultiplyVector2(const unsigned int key, const float value)
+{
+	m_properties.MultiplyVector2(key, value);
+}
+
+void ETHEntity::MultiplyVector3(const unsigned int key, const float value)
+{
+	m_properties.MultiplyVector3(key, value);
+}
+
+bool ETHEntity::EraseData(const unsigned int key)
+{
+	return m_properties.EraseData(key);
+}
+
+ETH_CUSTOM_DATA_TYPE ETHEntity::CheckCustomData(const unsigned int key) const
+{
+	return m_properties.Check(key);
+}
+
 ETH_CUSTOM_DATA_TYPE ETHEntity::CheckCustomData(const str_type::string &name) const
 {
 	return m_properties.Check(name);
@@ -167,6 +167,35 @@ public:
 
 	bool EraseData(const str_type::string &name);
 	ETH_CUSTOM_DATA_TYPE CheckCustomData(const str_type::string &name) const;
+
+	void SetFloat(const unsigned int key, const float value);
+	void SetInt(const unsigned int key, const int value);
+	void SetUInt(const unsigned int key, const unsigned int value);
+	void SetString(const unsigned int key, const str_type::string &value);
+	void SetVector2(const unsigned int key, const Vector2 &value);
+	void SetVector3(const unsigned int key, const Vector3 &value);
+
+	float GetFloat(const unsigned int key) const;
+	int GetInt(const unsigned int key) const;
+	unsigned int GetUInt(const unsigned int key) const;
+	str_type::string GetString(const unsigned int key) const;
+	Vector2 GetVector2(const unsigned int key) const;
+	Vector3 GetVector3(const unsigned int key) const;
+
+	void AddToFloat(const unsigned int key, const float value);
+	void AddToInt(const unsigned int key, const int value);
+	void AddToUInt(const unsigned int key, const unsigned int value);
+	void AddToVector2(const unsigned int key, const Vector2 &v);
+	void AddToVector3(const unsigned int key, const Vector3 &v);
+
+	void MultiplyFloat(const unsigned int key, const float value);
+	void MultiplyInt(const unsigned int key, const int value);
+	void MultiplyUInt(const unsigned int key, const unsigned int value);
+	void MultiplyVector2(const unsigned int key, const float value);
+	void MultiplyVector3(const unsigned int key, const float value);
+
+	bool EraseData(const unsigned int key);
+	ETH_CUSTOM_DATA_TYPE CheckCustomData(const unsigned int key) const;
 	bool HasCustomData() const;
 	void DebugPrintCustomData() const;
 	void ClearCustomData();
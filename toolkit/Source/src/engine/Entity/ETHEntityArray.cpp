@@ -22,6 +22,7 @@
 
 #include "ETHEntityArray.h"
 #include <set>
+#include <algorithm>
 
 ETHEntityArray::ETHEntityArray()
 {
@@ -136,4 +137,107 @@ void ETHEntityArray::removeDeadEntities()
 			iter++;
 		}
 	}
-}
\ No newline at end of file
+}
+
+void ETHEntityArray::addToPosition(const Vector3& v, ETHBucketManager& buckets)
+{
+	// bucket changes are only queued here and get resolved together by the scene
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); iter++)
+	{
+		(*iter)->AddToPosition(v, buckets);
+	}
+}
+
+void ETHEntityArray::addToPositionXY(const Vector2& v, ETHBucketManager& buckets)
+{
+	addToPosition(Vector3(v, 0.0f), buckets);
+}
+
+void ETHEntityArray::setColor(const Vector3& color)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); iter++)
+	{
+		(*iter)->SetColor(color);
+	}
+}
+
+void ETHEntityArray::setAlpha(const float alpha)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); iter++)
+	{
+		(*iter)->SetAlpha(alpha);
+	}
+}
+
+void ETHEntityArray::hide(const bool hide)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); iter++)
+	{
+		(*iter)->Hide(hide);
+	}
+}
+
+void ETHEntityArray::filterByName(const str_type::string& name)
+{
+	std::size_t kept = 0;
+	for (std::size_t t = 0; t < m_vector.size(); t++)
+	{
+		if (m_vector[t]->GetEntityName() == name)
+		{
+			m_vector[kept++] = m_vector[t];
+		}
+		else
+		{
+			m_vector[t]->Release();
+		}
+	}
+	m_vector.resize(kept);
+}
+
+void ETHEntityArray::filterByCustomData(const str_type::string& name)
+{
+	// if the name has never been used, no entity can hold it
+	const unsigned int key = ETHCustomDataManager::FindKey(name);
+	if (key == ETHCustomDataManager::INVALID_KEY)
+	{
+		clear();
+		return;
+	}
+
+	std::size_t kept = 0;
+	for (std::size_t t = 0; t < m_vector.size(); t++)
+	{
+		if (m_vector[t]->CheckCustomData(key) != ETHDT_NODATA)
+		{
+			m_vector[kept++] = m_vector[t];
+		}
+		else
+		{
+			m_vector[t]->Release();
+		}
+	}
+	m_vector.resize(kept);
+}
+
+static bool IsNearer(const std::pair<float, ETHEntityRawPtr>& a, const std::pair<float, ETHEntityRawPtr>& b)
+{
+	return (a.first < b.first);
+}
+
+void ETHEntityArray::sortByDistance(const Vector2& point)
+{
+	// compute every distance only once instead of on each comparison
+	std::vector<std::pair<float, ETHEntityRawPtr> > sorted(m_vector.size());
+	for (std::size_t t = 0; t < m_vector.size(); t++)
+	{
+		const Vector2 diff(m_vector[t]->GetPositionXY() - point);
+		sorted[t] = std::pair<float, ETHEntityRawPtr>((diff.x * diff.x) + (diff.y * diff.y), m_vector[t]);
+	}
+
+	std::stable_sort(sorted.begin(), sorted.end(), IsNearer);
+
+	for (std::size_t t = 0; t < m_vector.size(); t++)
+	{
+		m_vector[t] = sorted[t].second;
+	}
+}
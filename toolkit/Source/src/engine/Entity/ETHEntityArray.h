@@ -45,6 +45,22 @@ public:
 	void unique();
 	void removeDeadEntities();
 
+	// bulk operations, each one runs a single native loop over the array
+	void addToPosition(const Vector3& v, ETHBucketManager& buckets);
+	void addToPositionXY(const Vector2& v, ETHBucketManager& buckets);
+	void setColor(const Vector3& color);
+	void setAlpha(const float alpha);
+	void hide(const bool hide);
+
+	/// Keeps only the entities named 'name'
+	void filterByName(const str_type::string& name);
+
+	/// Keeps only the entities that have a custom variable named 'name'
+	void filterByCustomData(const str_type::string& name);
+
+	/// Sorts the array from the nearest to the farthest entity from 'point'
+	void sortByDistance(const Vector2& point);
+
 private:
 	std::vector<ETHEntityRawPtr> m_vector;
 	int m_ref;
@@ -66,3 +66,25 @@ bool ETHEntityDefaultChooser::Choose(ETHEntity* entity) const
 	GS2D_UNUSED_ARGUMENT(entity);
 	return true;
 }
+
+ETHEntityIgnoreFilter::ETHEntityIgnoreFilter(const gs2d::str_type::string& semicolonSeparatedNames)
+{
+	const std::vector<gs2d::str_type::string> names = ETHGlobal::SplitString(semicolonSeparatedNames, GS_L(";"));
+	for (std::size_t t = 0; t < names.size(); t++)
+	{
+		if (!names[t].empty())
+			m_names.insert(names[t]);
+	}
+}
+
+void ETHEntityIgnoreFilter::IgnoreID(const int id)
+{
+	m_ids.insert(id);
+}
+
+bool ETHEntityIgnoreFilter::Choose(ETHEntity* entity) const
+{
+	if (!m_ids.empty() && m_ids.find(entity->GetID()) != m_ids.end())
+		return false;
+	return (m_names.find(entity->GetEntityName()) == m_names.end());
+}
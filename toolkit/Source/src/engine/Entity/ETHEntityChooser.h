@@ -25,6 +25,7 @@
 
 #include "ETHEntity.h"
 #include <vector>
+#include <set>
 
 class ETHEntityChooser
 {
@@ -56,4 +57,18 @@ public:
 	bool Choose(ETHEntity* entity) const;
 };
 
+/// Ignore list that is parsed once and kept, so repeated queries don't split
+/// the name list again nor compare against every name in it
+class ETHEntityIgnoreFilter : public ETHEntityChooser
+{
+	std::set<gs2d::str_type::string> m_names;
+	std::set<int> m_ids;
+public:
+	ETHEntityIgnoreFilter(const gs2d::str_type::string& semicolonSeparatedNames);
+	void IgnoreID(const int id);
+	bool Choose(ETHEntity* entity) const;
+};
+
+typedef boost::shared_ptr<ETHEntityIgnoreFilter> ETHEntityIgnoreFilterPtr;
+
 #endif
@@ -46,7 +46,10 @@ public:
 
 	virtual void SetAngle(const float angle) = 0;
 	virtual bool HasAnyCallbackFunction() const = 0;
+	virtual bool HasConstructorCallback() const = 0;
 	virtual bool RunCallback(ETHScriptEntity* entity) = 0;
+	virtual asIScriptContext* GetScriptContext() = 0;
+	virtual int GetCallbackId() = 0;
 
 	virtual void Destroy() = 0;
 	virtual void Scale(const Vector2& scale, ETHEntity* entity) = 0;
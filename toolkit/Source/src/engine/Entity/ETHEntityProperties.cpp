@@ -311,7 +311,7 @@ bool ETHEntityProperties::ReadFromXMLFile(TiXmlElement *pElement)
 					{
 						if (pParticleIter)
 						{
-							boost::shared_ptr<ETH_PARTICLE_SYSTEM> newSystem = boost::shared_ptr<ETH_PARTICLE_SYSTEM>(new ETH_PARTICLE_SYSTEM);
+							ETHParticleSystemPtr newSystem = ETHParticleSystemPtr(new ETH_PARTICLE_SYSTEM);
 							newSystem->ReadFromXMLFile(pParticleIter);
 							if (newSystem->nParticles > 0)
 							{
@@ -95,7 +95,7 @@ protected:
 	float soundVolume;
 	Vector2 scale;
 	boost::shared_ptr<ETHCollisionBox> collision;
-	std::vector<boost::shared_ptr<ETH_PARTICLE_SYSTEM> > particleSystems;
+	std::vector<ETHParticleSystemPtr> particleSystems;
 	bool successfullyLoaded;
 };
 
@@ -72,6 +72,8 @@ public:
 	virtual void KillParticleSystem(const unsigned int n) = 0;
 	virtual bool ParticlesKilled(const unsigned int n) const = 0;
 	virtual bool PlayParticleSystem(const unsigned int n, const Vector2& zAxisDirection) = 0;
+	virtual bool FastForwardParticleSystem(const unsigned int n, const unsigned int milliseconds, const Vector2& zAxisDirection) = 0;
+	virtual bool SetParticleSystemSeed(const unsigned int n, const unsigned int seed, const Vector2& zAxisDirection) = 0;
 	virtual bool AreParticlesOver() const = 0;
 	virtual void SetSoundVolume(const float volume) = 0;
 	virtual ETHCollisionBox GetCollisionBox() const = 0;
@@ -152,6 +154,36 @@ public:
 
 	virtual bool EraseData(const str_type::string &name) = 0;
 	virtual ETH_CUSTOM_DATA_TYPE CheckCustomData(const str_type::string &name) const = 0;
+
+	// custom data access through keys from ETHCustomDataManager::GetKey, which skips the name lookup
+	virtual void SetFloat(const unsigned int key, const float value) = 0;
+	virtual void SetInt(const unsigned int key, const int value) = 0;
+	virtual void SetUInt(const unsigned int key, const unsigned int value) = 0;
+	virtual void SetString(const unsigned int key, const str_type::string &value) = 0;
+	virtual void SetVector2(const unsigned int key, const Vector2 &value) = 0;
+	virtual void SetVector3(const unsigned int key, const Vector3 &value) = 0;
+
+	virtual float GetFloat(const unsigned int key) const = 0;
+	virtual int GetInt(const unsigned int key) const = 0;
+	virtual unsigned int GetUInt(const unsigned int key) const = 0;
+	virtual str_type::string GetString(const unsigned int key) const = 0;
+	virtual Vector2 GetVector2(const unsigned int key) const = 0;
+	virtual Vector3 GetVector3(const unsigned int key) const = 0;
+
+	virtual void AddToFloat(const unsigned int key, const float value) = 0;
+	virtual void AddToInt(const unsigned int key, const int value) = 0;
+	virtual void AddToUInt(const unsigned int key, const unsigned int value) = 0;
+	virtual void AddToVector2(const unsigned int key, const Vector2 &v) = 0;
+	virtual void AddToVector3(const unsigned int key, const Vector3 &v) = 0;
+
+	virtual void MultiplyFloat(const unsigned int key, const float value) = 0;
+	virtual void MultiplyInt(const unsigned int key, const int value) = 0;
+	virtual void MultiplyUInt(const unsigned int key, const unsigned int value) = 0;
+	virtual void MultiplyVector2(const unsigned int key, const float value) = 0;
+	virtual void MultiplyVector3(const unsigned int key, const float value) = 0;
+
+	virtual bool EraseData(const unsigned int key) = 0;
+	virtual ETH_CUSTOM_DATA_TYPE CheckCustomData(const unsigned int key) const = 0;
 	virtual void DebugPrintCustomData() const = 0;
 	virtual bool HasCustomData() const = 0;
 	virtual void ClearCustomData() = 0;
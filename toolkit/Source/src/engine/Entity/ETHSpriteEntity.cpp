@@ -214,7 +214,7 @@ void ETHSpriteEntity::LoadParticleSystem()
 	m_particles.resize(m_properties.particleSystems.size());
 	for (std::size_t t=0; t<m_properties.particleSystems.size(); t++)
 	{
-		const ETH_PARTICLE_SYSTEM *pSystem = m_properties.particleSystems[t].get();
+		const ETHParticleSystemPtr& pSystem = m_properties.particleSystems[t];
 		if (pSystem->nParticles > 0)
 		{
 			str_type::string path = resourcePath;
@@ -226,7 +226,7 @@ void ETHSpriteEntity::LoadParticleSystem()
 				continue;
 
 			m_particles[t] = ETHParticleManagerPtr(
-				new ETHParticleManager(m_provider, *pSystem, GetPositionXY(), GetPosition(), GetAngle(), m_properties.soundVolume));
+				new ETHParticleManager(m_provider, pSystem, GetPositionXY(), GetPosition(), GetAngle(), m_properties.soundVolume));
 			m_particles[t]->ScaleParticleSystem((GetScale().x + GetScale().y) / 2.0f);
 		}
 	}
@@ -517,10 +517,12 @@ bool ETHSpriteEntity::AreParticlesOver() const
 
 void ETHSpriteEntity::UpdateParticleSystems(const Vector2& zAxisDirection, const unsigned long lastFrameElapsedTime)
 {
+	const Vector2 parallaxOffset = ComputeParallaxOffset();
 	for (std::size_t t=0; t<m_particles.size(); t++)
 	{
 		if (m_particles[t])
-			m_particles[t]->UpdateParticleSystem(ETHGlobal::ToScreenPos(GetPosition(), zAxisDirection), GetPosition(), GetAngle(), lastFrameElapsedTime);
+			m_particles[t]->UpdateParticleSystem(ETHGlobal::ToScreenPos(GetPosition(), zAxisDirection), GetPosition(), GetAngle(),
+												 lastFrameElapsedTime, parallaxOffset);
 	}
 }
 
@@ -748,6 +750,32 @@ bool ETHSpriteEntity::PlayParticleSystem(const unsigned int n, const Vector2& zA
 	}
 }
 
+bool ETHSpriteEntity::FastForwardParticleSystem(const unsigned int n, const unsigned int milliseconds, const Vector2& zAxisDirection)
+{
+	if (n >= m_particles.size() || !m_particles[n])
+	{
+		ETH_STREAM_DECL(ss) << GS_L("ETHRenderEntity::FastForwardParticleSystem: invalid particle system index");
+		m_provider->Log(ss.str(), Platform::Logger::ERROR);
+		return false;
+	}
+	const Vector3 v3Pos = GetPosition();
+	m_particles[n]->FastForward(ETHGlobal::ToScreenPos(v3Pos, zAxisDirection), v3Pos, GetAngle(), milliseconds);
+	return true;
+}
+
+bool ETHSpriteEntity::SetParticleSystemSeed(const unsigned int n, const unsigned int seed, const Vector2& zAxisDirection)
+{
+	if (n >= m_particles.size() || !m_particles[n])
+	{
+		ETH_STREAM_DECL(ss) << GS_L("ETHRenderEntity::SetParticleSystemSeed: invalid particle system index");
+		m_provider->Log(ss.str(), Platform::Logger::ERROR);
+		return false;
+	}
+	const Vector3 v3Pos = GetPosition();
+	m_particles[n]->SetRandomSeed(seed, ETHGlobal::ToScreenPos(v3Pos, zAxisDirection), v3Pos, GetAngle());
+	return true;
+}
+
 void ETHSpriteEntity::KillParticleSystem(const unsigned int n)
 {
 	if (n >= m_particles.size())
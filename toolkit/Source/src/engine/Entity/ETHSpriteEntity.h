@@ -68,6 +68,8 @@ public:
 	void SetStopSFXWhenDestroyed(const bool enable);
 	void SilenceParticleSystems(const bool silence);
 	bool PlayParticleSystem(const unsigned int n, const Vector2& zAxisDirection);
+	bool FastForwardParticleSystem(const unsigned int n, const unsigned int milliseconds, const Vector2& zAxisDirection);
+	bool SetParticleSystemSeed(const unsigned int n, const unsigned int seed, const Vector2& zAxisDirection);
 	void KillParticleSystem(const unsigned int n);
 	bool ParticlesKilled(const unsigned int n) const;
 	void SetSoundVolume(const float volume);
@@ -23,57 +23,182 @@
 #include "ETHContactListener.h"
 #include "ETHPhysicsSimulator.h"
 #include "../Entity/ETHEntity.h"
+#include <algorithm>
 
-static void GetContactData(const b2Contact* contact, ETHPhysicsEntityController** controllerA, ETHPhysicsEntityController** controllerB,
-						   ETHEntity **entityA, ETHEntity **entityB, Vector2& v2Point0, Vector2& v2Point1, Vector2& v2Normal, const bool beginFunc)
+static inline ETHPhysicsEntityController* GetEntityController(ETHEntity* entity)
 {
-	b2WorldManifold worldManifold; 
-	contact->GetWorldManifold(&worldManifold); 
+	return static_cast<ETHPhysicsEntityController*>(entity->GetController().get());
+}
+
+ETHContactListener::ETHContactListener() :
+	m_numRetained(0),
+	m_stepping(false)
+{
+}
+
+ETHContactListener::~ETHContactListener()
+{
+	for (std::size_t t = 0; t < m_numRetained; t++)
+	{
+		m_events[t].entityA->Release();
+		m_events[t].entityB->Release();
+	}
+}
+
+void ETHContactListener::BeginStep()
+{
+	m_stepping = true;
+}
 
-	const b2Body* bodyA = contact->GetFixtureA()->GetBody();
-	*entityA = static_cast<ETHEntity*>(bodyA->GetUserData());
+void ETHContactListener::EndStep()
+{
+	m_stepping = false;
+}
 
-	*controllerA = static_cast<ETHPhysicsEntityController*>((*entityA)->GetController().get());
+void ETHContactListener::RetainContacts()
+{
+	for (; m_numRetained < m_events.size(); m_numRetained++)
+	{
+		m_events[m_numRetained].entityA->AddRef();
+		m_events[m_numRetained].entityB->AddRef();
+	}
+}
+
+void ETHContactListener::BeginContact(b2Contact* contact)
+{
+	RecordContact(contact, true);
+}
+
+void ETHContactListener::EndContact(b2Contact* contact)
+{
+	RecordContact(contact, false);
+}
 
-	const b2Body* bodyB = contact->GetFixtureB()->GetBody();
-	*entityB = static_cast<ETHEntity*>(bodyB->GetUserData());
-	*controllerB = static_cast<ETHPhysicsEntityController*>((*entityB)->GetController().get());
+void ETHContactListener::RecordContact(b2Contact* contact, const bool begin)
+{
+	ETHEntity* entityA = static_cast<ETHEntity*>(contact->GetFixtureA()->GetBody()->GetUserData());
+	ETHEntity* entityB = static_cast<ETHEntity*>(contact->GetFixtureB()->GetBody()->GetUserData());
+	ETHPhysicsEntityController* controllerA = GetEntityController(entityA);
+	ETHPhysicsEntityController* controllerB = GetEntityController(entityB);
 
-	if (beginFunc)
+	// don't even compute the manifold if nobody is listening
+	if (begin)
 	{
-		if (!(*controllerA)->HasBeginContactCallback() && !(*controllerB)->HasBeginContactCallback())
+		if (!controllerA->HasBeginContactCallback() && !controllerB->HasBeginContactCallback())
 			return;
 	}
 	else
 	{
-		if (!(*controllerA)->HasEndContactCallback() && !(*controllerB)->HasEndContactCallback())
+		if (!controllerA->HasEndContactCallback() && !controllerB->HasEndContactCallback())
 			return;
 	}
 
-	const b2Vec2& point0 = worldManifold.points[0];
-	const b2Vec2& point1 = worldManifold.points[1];
-	const b2Vec2& normal = worldManifold.normal;
-	v2Point0 = Vector2(point0.x, point0.y);
-	v2Point1 = Vector2(point1.x, point1.y);
-	v2Normal = Vector2(normal.x, normal.y);
+	b2WorldManifold worldManifold; 
+	contact->GetWorldManifold(&worldManifold); 
+
+	CONTACT_EVENT contactEvent;
+	contactEvent.entityA = entityA;
+	contactEvent.entityB = entityB;
+	contactEvent.point0 = Vector2(worldManifold.points[0].x, worldManifold.points[0].y);
+	contactEvent.point1 = Vector2(worldManifold.points[1].x, worldManifold.points[1].y);
+	contactEvent.normal = Vector2(worldManifold.normal.x, worldManifold.normal.y);
+	contactEvent.begin = begin;
+	contactEvent.duplicate = false;
+	m_events.push_back(contactEvent);
+
+	// the entities must stay alive until their callbacks are run, but reference counts can't
+	// be touched from the worker thread. Contacts ended outside the step, by destroying a
+	// body, are referenced right away since their entity may be about to be released
+	if (!m_stepping)
+		RetainContacts();
 }
 
-void ETHContactListener::BeginContact(b2Contact* contact)
+bool ETHContactListener::CONTACT_EVENT_ORDER::operator()(const std::size_t a, const std::size_t b) const
 {
-	Vector2 point0, point1, normal;
-	ETHEntity *entityA = 0, *entityB = 0;
-	ETHPhysicsEntityController* controllerA = 0, *controllerB = 0;
-	GetContactData(contact, &controllerA, &controllerB, &entityA, &entityB, point0, point1, normal, true);
-	controllerA->RunBeginContactCallback(entityB, point0, point1, normal);
-	controllerB->RunBeginContactCallback(entityA, point0, point1, normal);
+	const CONTACT_EVENT& ea = (*events)[a];
+	const CONTACT_EVENT& eb = (*events)[b];
+	const ETHEntity* minA = Min(ea.entityA, ea.entityB);
+	const ETHEntity* minB = Min(eb.entityA, eb.entityB);
+	if (minA != minB)
+		return (minA < minB);
+	const ETHEntity* maxA = Max(ea.entityA, ea.entityB);
+	const ETHEntity* maxB = Max(eb.entityA, eb.entityB);
+	if (maxA != maxB)
+		return (maxA < maxB);
+	if (ea.begin != eb.begin)
+		return ea.begin;
+	return (a < b);
 }
 
-void ETHContactListener::EndContact(b2Contact* contact)
+void ETHContactListener::MarkDuplicates()
+{
+	// compound shapes touch through many fixtures at once, but scripts
+	// want to hear about each pair of bodies only once per event type
+	m_order.resize(m_dispatching.size());
+	for (std::size_t t = 0; t < m_order.size(); t++)
+	{
+		m_order[t] = t;
+	}
+
+	CONTACT_EVENT_ORDER order;
+	order.events = &m_dispatching;
+	std::sort(m_order.begin(), m_order.end(), order);
+
+	for (std::size_t t = 1; t < m_order.size(); t++)
+	{
+		const CONTACT_EVENT& previous = m_dispatching[m_order[t - 1]];
+		CONTACT_EVENT& current = m_dispatching[m_order[t]];
+		if (previous.begin == current.begin
+			&& Min(previous.entityA, previous.entityB) == Min(current.entityA, current.entityB)
+			&& Max(previous.entityA, previous.entityB) == Max(current.entityA, current.entityB))
+		{
+			current.duplicate = true;
+		}
+	}
+}
+
+void ETHContactListener::DispatchContacts()
+{
+	if (m_events.empty())
+		return;
+
+	// callbacks may destroy bodies and generate new events, so take the list out first
+	RetainContacts();
+	m_dispatching.swap(m_events);
+	m_numRetained = 0;
+	MarkDuplicates();
+
+	for (std::size_t t = 0; t < m_dispatching.size(); t++)
+	{
+		CONTACT_EVENT& contactEvent = m_dispatching[t];
+		if (!contactEvent.duplicate)
+		{
+			ETHPhysicsEntityController* controllerA = GetEntityController(contactEvent.entityA);
+			ETHPhysicsEntityController* controllerB = GetEntityController(contactEvent.entityB);
+
+			// skip sides whose body was destroyed after the event was recorded
+			if (contactEvent.begin)
+			{
+				if (controllerA->GetBody())
+					controllerA->RunBeginContactCallback(contactEvent.entityB, contactEvent.point0, contactEvent.point1, contactEvent.normal);
+				if (controllerB->GetBody())
+					controllerB->RunBeginContactCallback(contactEvent.entityA, contactEvent.point0, contactEvent.point1, contactEvent.normal);
+			}
+			else
+			{
+				if (controllerA->GetBody())
+					controllerA->RunEndContactCallback(contactEvent.entityB, contactEvent.point0, contactEvent.point1, contactEvent.normal);
+				if (controllerB->GetBody())
+					controllerB->RunEndContactCallback(contactEvent.entityA, contactEvent.point0, contactEvent.point1, contactEvent.normal);
+			}
+		}
+		contactEvent.entityA->Release();
+		contactEvent.entityB->Release();
+	}
+	m_dispatching.clear();
+}
+
+std::size_t ETHContactListener::GetNumPendingContacts() const
 {
-	Vector2 point0, point1, normal;
-	ETHEntity *entityA = 0, *entityB = 0;
-	ETHPhysicsEntityController* controllerA = 0, *controllerB = 0;
-	GetContactData(contact, &controllerA, &controllerB, &entityA, &entityB, point0, point1, normal, false);
-	controllerA->RunEndContactCallback(entityB, point0, point1, normal);
-	controllerB->RunEndContactCallback(entityA, point0, point1, normal);
+	return m_events.size();
 }
@@ -24,11 +24,58 @@
 #define ETH_CONTACT_LISTENER
 
 #include <Box2D/Box2D.h>
+#include "../../gs2d/src/gs2dmath.h"
+#include <vector>
 
+class ETHEntity;
+
+/// Records contacts while the world is being stepped. Script callbacks are only
+/// run by DispatchContacts, once the step is over, and only once per body pair.
+/// The step may run in a worker thread, so entities recorded between BeginStep and
+/// EndStep are only referenced once RetainContacts is called from the main thread
 class ETHContactListener : public b2ContactListener
 {
+	struct CONTACT_EVENT
+	{
+		ETHEntity* entityA;
+		ETHEntity* entityB;
+		gs2d::math::Vector2 point0, point1, normal;
+		bool begin;
+		bool duplicate;
+	};
+
+	struct CONTACT_EVENT_ORDER
+	{
+		const std::vector<CONTACT_EVENT>* events;
+		bool operator()(const std::size_t a, const std::size_t b) const;
+	};
+
+	std::vector<CONTACT_EVENT> m_events;
+	std::vector<CONTACT_EVENT> m_dispatching;
+	std::vector<std::size_t> m_order;
+	std::size_t m_numRetained;
+	bool m_stepping;
+
 	void BeginContact(b2Contact* contact); 
 	void EndContact(b2Contact* contact);
+	void RecordContact(b2Contact* contact, const bool begin);
+	void MarkDuplicates();
+
+public:
+	ETHContactListener();
+	~ETHContactListener();
+
+	/// Called by whatever thread steps the world, right before and after the step
+	void BeginStep();
+	void EndStep();
+
+	/// Reference the entities of the contacts recorded during the last step. Must be
+	/// called from the main thread once the step is over, before anything can delete them
+	void RetainContacts();
+
+	/// Run the callbacks of every contact recorded since the last call
+	void DispatchContacts();
+	std::size_t GetNumPendingContacts() const;
 };
 
-#endif
\ No newline at end of file
+#endif
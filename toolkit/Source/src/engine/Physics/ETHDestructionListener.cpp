@@ -24,6 +24,16 @@
 #include "../Entity/ETHRenderEntity.h"
 #include "ETHPhysicsEntityController.h"
 
+ETHDestructionListener::ETHDestructionListener() :
+	m_sleepListener(0)
+{
+}
+
+void ETHDestructionListener::SetSleepListener(ETHBodySleepListener* listener)
+{
+	m_sleepListener = listener;
+}
+
 void ETHDestructionListener::SayGoodbye(b2Joint* joint)
 {
 	ETHEntity *jointOwner = static_cast<ETHEntity*>(joint->GetUserData());
@@ -36,6 +46,8 @@ void ETHDestructionListener::SayGoodbye(b2Joint* joint)
 
 void ETHDestructionListener::SayGoodbye(b2Fixture* fixture)
 {
-	GS2D_UNUSED_ARGUMENT(fixture);
-	// Let's not say goodbye to these guys
+	// fixtures only go away along with their bodies
+	ETHEntity* entity = static_cast<ETHEntity*>(fixture->GetBody()->GetUserData());
+	if (m_sleepListener && entity)
+		m_sleepListener->BodyWokeUp(entity);
 }
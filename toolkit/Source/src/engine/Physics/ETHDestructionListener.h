@@ -25,11 +25,18 @@
 
 #include <Box2D/Box2D.h>
 #include <boost/shared_ptr.hpp>
+#include "ETHBodySleepListener.h"
 
 class ETHDestructionListener : public b2DestructionListener
 {
+	ETHBodySleepListener* m_sleepListener;
+
 	void SayGoodbye(b2Joint* joint);
 	void SayGoodbye(b2Fixture* fixture);
+
+public:
+	ETHDestructionListener();
+	void SetSleepListener(ETHBodySleepListener* listener);
 };
 
 typedef boost::shared_ptr<ETHDestructionListener> ETHDestructionListenerPtr;
@@ -44,7 +44,7 @@ void ETHPhysicsController::Release()
 
 ETH_BODY_SHAPE ETHPhysicsController::GetShape() const
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return ETHBS_NONE;
 	const ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
 	if (!entity) return ETHBS_NONE;
@@ -53,70 +53,70 @@ ETH_BODY_SHAPE ETHPhysicsController::GetShape() const
 
 void ETHPhysicsController::SetGravityScale(const float scale)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->SetGravityScale(scale);
 }
 
 float ETHPhysicsController::GetGravityScale() const
 {
-	const b2Body* body = m_controller->m_body;
+	const b2Body* body = m_controller->GetBody();
 	if (!body) return 0.0f;
 	return body->GetGravityScale();
 }
 
 void ETHPhysicsController::SetAngularVelocity(const float velocity)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->SetAngularVelocity(velocity);
 }
 
 void ETHPhysicsController::SetAwake(const bool awake)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->SetAwake(awake);
 }
 
 void ETHPhysicsController::SetBullet(const bool enable)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->SetBullet(enable);
 }
 
 bool ETHPhysicsController::IsAwake() const
 {
-	const b2Body* body = m_controller->m_body;
+	const b2Body* body = m_controller->GetBody();
 	if (!body) return false;
 	return body->IsAwake();
 }
 
 bool ETHPhysicsController::IsBullet() const
 {
-	const b2Body* body = m_controller->m_body;
+	const b2Body* body = m_controller->GetBody();
 	if (!body) return false;
 	return body->IsBullet();
 }
 
 float ETHPhysicsController::GetMass() const
 {
-	const b2Body* body = m_controller->m_body;
+	const b2Body* body = m_controller->GetBody();
 	if (!body) return 0.0f;
 	return body->GetMass();
 }
 
 float ETHPhysicsController::GetAngularVelocity() const
 {
-	const b2Body* body = m_controller->m_body;
+	const b2Body* body = m_controller->GetBody();
 	if (!body) return 0.0f;
 	return body->GetAngularVelocity();
 }
 
 gs2d::math::Vector2 ETHPhysicsController::GetLinearVelocity() const
 {
-	const b2Body* body = m_controller->m_body;
+	const b2Body* body = m_controller->GetBody();
 	if (!body) return Vector2(0.0f, 0.0f);
 	const b2Vec2& v = body->GetLinearVelocity();
 	return Vector2(v.x, v.y);
@@ -124,49 +124,49 @@ gs2d::math::Vector2 ETHPhysicsController::GetLinearVelocity() const
 
 void ETHPhysicsController::ApplyTorque(const float torque)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->ApplyTorque(torque);
 }
 
 void ETHPhysicsController::ApplyForce(const Vector2& force, const Vector2& point)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->ApplyForce(m_globalScaleManager->GetScale() * b2Vec2(force.x, force.y), b2Vec2(point.x, point.y));
 }
 
 void ETHPhysicsController::ApplyForceToCenter(const Vector2& force)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->ApplyForceToCenter(m_globalScaleManager->GetScale() * b2Vec2(force.x, force.y));
 }
 
 void ETHPhysicsController::SetLinearVelocity(const Vector2& velocity)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->SetLinearVelocity(m_globalScaleManager->GetScale() * b2Vec2(velocity.x, velocity.y));
 }
 
 void ETHPhysicsController::ApplyAngularImpulse(const float impulse)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->ApplyAngularImpulse(impulse);
 }
 
 void ETHPhysicsController::ApplyLinearImpulse(const Vector2& impulse, const Vector2& point)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->ApplyLinearImpulse(b2Vec2(impulse.x, impulse.y), b2Vec2(point.x, point.y));
 }
 
 bool ETHPhysicsController::IsSensor() const
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return false;
 	const ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
 	if (!entity) return false;
@@ -175,7 +175,7 @@ bool ETHPhysicsController::IsSensor() const
 
 bool ETHPhysicsController::IsFixedRotation() const
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return false;
 	const ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
 	if (!entity) return false;
@@ -184,28 +184,28 @@ bool ETHPhysicsController::IsFixedRotation() const
 
 float ETHPhysicsController::GetFriction() const
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return 0.0f;
 	return body->GetFixtureList()->GetFriction();  // TODO/TO-DO: manipulate next fixtures
 }
 
 void ETHPhysicsController::SetFriction(const float friction)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	body->GetFixtureList()->SetFriction(friction); // TODO/TO-DO: manipulate next fixtures
 }
 
 float ETHPhysicsController::GetRestitution() const
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return 0.0f;
 	return body->GetFixtureList()->GetRestitution();  // TODO/TO-DO: manipulate next fixtures
 }
 
 void ETHPhysicsController::SetRestitution(const float res)
 {
-	b2Body* body = m_controller->m_body;
+	b2Body* body = m_controller->GetBody();
 	if (!body) return;
 	return body->GetFixtureList()->SetRestitution(res);  // TODO/TO-DO: manipulate next fixtures
 }
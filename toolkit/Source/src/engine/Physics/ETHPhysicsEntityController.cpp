@@ -21,24 +21,34 @@
 --------------------------------------------------------------------------------------*/
 
 #include "ETHPhysicsEntityController.h"
-
-#ifdef GS2D_STR_TYPE_WCHAR
-#include "../../addons/utf16/scriptbuilder.h"
-#else
-#include "../../addons/ansi/scriptbuilder.h"
-#endif
-
 #include "../ETHEngine.h"
 #include "ETHPhysicsController.h"
+#include "../Script/ETHCallbackFunctionCache.h"
 
 ETHPhysicsEntityController::ETHPhysicsEntityController(const ETHEntityControllerPtr& old, b2Body* body,
-													   boost::shared_ptr<b2World> world, asIScriptModule* module, asIScriptContext* context) :
+													   boost::shared_ptr<b2World> world, const ETHPhysicsStepGuardPtr& stepGuard,
+													   asIScriptModule* module, asIScriptContext* context) :
 	ETHRawEntityController(old, 0,-1,-1),
 	m_body(body),
 	m_world(world),
+	m_stepGuard(stepGuard),
 	m_beginContactCallbackId(-1),
-	m_endContactCallbackId(-1)
+	m_endContactCallbackId(-1),
+	m_previousPosition(0.0f, 0.0f),
+	m_previousAngle(0.0f),
+	m_interpolationAlpha(1.0f),
+	m_usePublishedTransform(false),
+	m_publishedActive(false),
+	m_publishedPos(0.0f, 0.0f),
+	m_publishedAngle(0.0f),
+	m_transformSettled(false),
+	m_sleepReported(false)
 {
+	if (m_body)
+	{
+		m_previousPosition = m_body->GetPosition();
+		m_previousAngle = m_body->GetAngle();
+	}
 	ETHRawEntityControllerPtr raw = boost::dynamic_pointer_cast<ETHRawEntityController>(old);
 	if (raw)
 	{
@@ -50,39 +60,131 @@ ETHPhysicsEntityController::ETHPhysicsEntityController(const ETHEntityController
 	}
 }
 
+ETHPhysicsEntityController::~ETHPhysicsEntityController()
+{
+	// the joints are destroyed along with the controller
+	m_stepGuard->Wait();
+}
+
 int ETHPhysicsEntityController::GetContactCallbackId(const str_type::string& prefix, asIScriptModule* module)
 {
 	ETHEntity* entity = static_cast<ETHEntity*>(m_body->GetUserData());
-	str_type::stringstream ss;
-	ss << prefix << ETHGlobal::RemoveExtension(entity->GetEntityName().c_str());
-	return CScriptBuilder::GetFunctionIdByName(module, ss.str());
+	return ETHCallbackFunctionCache::FindCallbackFunction(module, entity, prefix);
 }
 
 void ETHPhysicsEntityController::Update(const unsigned long lastFrameElapsedTime, ETHBucketManager& buckets)
+{
+	// the simulator has already synced the transform after stepping
+	GS2D_UNUSED_ARGUMENT(lastFrameElapsedTime);
+	GS2D_UNUSED_ARGUMENT(buckets);
+}
+
+void ETHPhysicsEntityController::SyncTransform(ETHBucketManager& buckets)
 {
 	if (!m_body)
 		return;
 
-	if (!m_body->IsActive())
-		return;
+	Vector2 pos;
+	if (m_usePublishedTransform)
+	{
+		if (!m_publishedActive)
+			return;
+		pos = m_publishedPos;
+		m_angle = m_publishedAngle;
+	}
+	else
+	{
+		if (!m_body->IsActive())
+			return;
+		pos = GetInterpolatedPos();
+		m_angle = GetInterpolatedAngle();
+	}
 
-	GS2D_UNUSED_ARGUMENT(lastFrameElapsedTime);
-	const Vector2 pos = ETHPhysicsSimulator::ScaleFromBox2D(m_body->GetPosition());
 	const Vector2 oldPos = Vector2(m_pos.x, m_pos.y);
 	if (oldPos != pos)
 	{
 		m_pos = Vector3(pos, GetPos().z);
 		buckets.RequestBucketMove(static_cast<ETHEntity*>(m_body->GetUserData()), oldPos, pos);
 	}
-	m_angle =-RadianToDegree(m_body->GetAngle());
+
+	// once the interpolation has caught up with a sleeping body, there's nothing left to sync
+	m_transformSettled = (!m_body->IsAwake()
+		&& pos == ETHPhysicsSimulator::ScaleFromBox2D(m_body->GetPosition())
+		&& m_angle == -RadianToDegree(m_body->GetAngle()));
+}
+
+bool ETHPhysicsEntityController::IsTransformSettled() const
+{
+	return m_transformSettled;
+}
+
+bool ETHPhysicsEntityController::IsSleepReported() const
+{
+	return m_sleepReported;
+}
+
+void ETHPhysicsEntityController::SetSleepReported(const bool reported)
+{
+	m_sleepReported = reported;
+}
+
+void ETHPhysicsEntityController::SetUsePublishedTransform(const bool use)
+{
+	m_usePublishedTransform = use;
+	if (use)
+		PublishTransform();
+}
+
+void ETHPhysicsEntityController::PublishTransform()
+{
+	if (!m_body)
+		return;
+	m_publishedActive = m_body->IsActive();
+	m_publishedPos = GetInterpolatedPos();
+	m_publishedAngle = GetInterpolatedAngle();
+}
+
+void ETHPhysicsEntityController::SetInterpolation(const float alpha, const bool storeCurrentTransform)
+{
+	m_interpolationAlpha = alpha;
+	if (storeCurrentTransform && m_body)
+	{
+		m_previousPosition = m_body->GetPosition();
+		m_previousAngle = m_body->GetAngle();
+	}
+}
+
+Vector2 ETHPhysicsEntityController::GetInterpolatedPos() const
+{
+	if (!m_body)
+		return Vector2(m_pos.x, m_pos.y);
+	const b2Vec2& current = m_body->GetPosition();
+	if (m_interpolationAlpha >= 1.0f)
+		return ETHPhysicsSimulator::ScaleFromBox2D(current);
+	const b2Vec2 pos = m_previousPosition + m_interpolationAlpha * (current - m_previousPosition);
+	return ETHPhysicsSimulator::ScaleFromBox2D(pos);
+}
+
+float ETHPhysicsEntityController::GetInterpolatedAngle() const
+{
+	if (!m_body)
+		return m_angle;
+	const float32 current = m_body->GetAngle();
+	if (m_interpolationAlpha >= 1.0f)
+		return -RadianToDegree(current);
+	return -RadianToDegree(m_previousAngle + m_interpolationAlpha * (current - m_previousAngle));
 }
 
 void ETHPhysicsEntityController::SetPos(const Vector3& pos)
 {
 	if (m_body)
 	{
+		m_stepGuard->Wait();
 		m_body->SetTransform(ETHPhysicsSimulator::ScaleToBox2D(Vector2(pos.x, pos.y)), m_body->GetAngle());
 		m_body->SetAwake(true);
+		// teleported bodies must not be interpolated from where they were
+		SetInterpolation(m_interpolationAlpha, true);
+		PublishTransform();
 	}
 	m_pos = pos;
 }
@@ -91,8 +193,11 @@ void ETHPhysicsEntityController::AddToPos(const Vector3& pos)
 {
 	if (m_body)
 	{
+		m_stepGuard->Wait();
 		m_body->SetTransform(ETHPhysicsSimulator::ScaleToBox2D(Vector2(pos.x, pos.y)) + m_body->GetPosition(), m_body->GetAngle());
 		m_body->SetAwake(true);
+		SetInterpolation(m_interpolationAlpha, true);
+		PublishTransform();
 	}
 	m_pos += pos;
 }
@@ -101,8 +206,11 @@ void ETHPhysicsEntityController::AddToAngle(const float angle)
 {
 	if (m_body)
 	{
+		m_stepGuard->Wait();
 		m_body->SetTransform(m_body->GetPosition(),-DegreeToRadian(angle) + m_body->GetAngle());
 		m_body->SetAwake(true);
+		SetInterpolation(m_interpolationAlpha, true);
+		PublishTransform();
 	}
 }
 
@@ -110,13 +218,17 @@ void ETHPhysicsEntityController::SetAngle(const float angle)
 {
 	if (m_body)
 	{
+		m_stepGuard->Wait();
 		m_body->SetTransform(m_body->GetPosition(),-DegreeToRadian(angle));
 		m_body->SetAwake(true);
+		SetInterpolation(m_interpolationAlpha, true);
+		PublishTransform();
 	}
 }
 
 void ETHPhysicsEntityController::Destroy()
 {
+	m_stepGuard->Wait();
 	for (std::size_t t = 0; t < m_joints.size(); t++)
 	{
 		if (m_joints[t])
@@ -127,9 +239,11 @@ void ETHPhysicsEntityController::Destroy()
 	m_joints.clear();
 	if (m_body)
 	{
-		static_cast<ETHEntity*>(m_body->GetUserData())->Release();
+		// the destruction listener still needs the entity while the body is destroyed
+		ETHEntity* entity = static_cast<ETHEntity*>(m_body->GetUserData());
 		m_world->DestroyBody(m_body);
 		m_body = 0;
+		entity->Release();
 	}
 }
 
@@ -186,6 +300,7 @@ bool ETHPhysicsEntityController::IsValidFunction(const int functionId) const
 
 b2Body* ETHPhysicsEntityController::GetBody()
 {
+	m_stepGuard->Wait();
 	return m_body;
 }
 
@@ -226,6 +341,7 @@ bool ETHPhysicsEntityController::ResolveJoints(ETHEntityArray& entities, const E
 
 void ETHPhysicsEntityController::RemoveJoints()
 {
+	m_stepGuard->Wait();
 	m_joints.clear();
 }
 
@@ -252,6 +368,7 @@ std::size_t ETHPhysicsEntityController::GetNumJoints() const
 
 ETHJointPtr ETHPhysicsEntityController::GetJoint(const std::size_t joindIdx)
 {
+	m_stepGuard->Wait();
 	if (joindIdx < GetNumJoints())
 		return m_joints[joindIdx];
 	else
@@ -27,6 +27,7 @@
 #include "../Entity/ETHEntity.h"
 #include "../Entity/ETHEntityArray.h"
 #include "ETHJoint.h"
+#include "ETHPhysicsStepGuard.h"
 
 using namespace gs2d::math;
 using namespace gs2d;
@@ -41,15 +42,26 @@ class ETHPhysicsEntityController : public ETHRawEntityController
 protected:
 	b2Body* m_body;
 	boost::shared_ptr<b2World> m_world;
+	ETHPhysicsStepGuardPtr m_stepGuard;
 	int m_beginContactCallbackId;
 	int m_endContactCallbackId;
 	std::vector<ETHJointPtr> m_joints;
+	b2Vec2 m_previousPosition;
+	float32 m_previousAngle;
+	float m_interpolationAlpha;
+	bool m_usePublishedTransform;
+	bool m_publishedActive;
+	Vector2 m_publishedPos;
+	float m_publishedAngle;
+	bool m_transformSettled;
+	bool m_sleepReported;
 	int GetContactCallbackId(const str_type::string& prefix, asIScriptModule* module);
 	bool IsValidFunction(const int functionId) const;
 
 public:
 	ETHPhysicsEntityController(const ETHEntityControllerPtr& old, b2Body* body, boost::shared_ptr<b2World> world,
-		asIScriptModule* module, asIScriptContext* context);
+		const ETHPhysicsStepGuardPtr& stepGuard, asIScriptModule* module, asIScriptContext* context);
+	~ETHPhysicsEntityController();
 	void Update(const unsigned long lastFrameElapsedTime, ETHBucketManager& buckets);
 	void SetPos(const Vector3& pos);
 	void AddToPos(const Vector3& pos);
@@ -66,7 +78,33 @@ public:
 	void KillJoint(b2Joint* joint);
 	std::size_t GetNumJoints() const;
 	ETHJointPtr GetJoint(const std::size_t joindIdx);
+
+	/// Waits for the world step running in the background, if there's any, so the body can be used right away
 	b2Body* GetBody();
+
+	/// Set how far the rendered transform lies between the transform stored for the previous
+	/// physics step and the current one. If storeCurrentTransform is true, the current body
+	/// transform becomes the previous one
+	void SetInterpolation(const float alpha, const bool storeCurrentTransform);
+	Vector2 GetInterpolatedPos() const;
+	float GetInterpolatedAngle() const;
+
+	/// While the world is being stepped in another thread, Update must not read the body.
+	/// In that case, it uses the transform copied by the last PublishTransform call
+	void SetUsePublishedTransform(const bool use);
+	void PublishTransform();
+
+	/// Move the entity to where its body is, requesting a bucket move if needed. Called
+	/// by the simulator after each step, so Update doesn't need to do it
+	void SyncTransform(ETHBucketManager& buckets);
+
+	/// True if the body was asleep and the entity had already reached its final
+	/// transform last time it was synced
+	bool IsTransformSettled() const;
+
+	/// Whether the simulator has told its sleep listener that this body fell asleep
+	bool IsSleepReported() const;
+	void SetSleepReported(const bool reported);
 };
 
 typedef boost::shared_ptr<ETHPhysicsEntityController> ETHPhysicsEntityControllerPtr;
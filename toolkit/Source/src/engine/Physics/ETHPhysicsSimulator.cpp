@@ -25,8 +25,10 @@
 
 const b2Vec2 ETHPhysicsSimulator::DEFAULT_GRAVITY(0, 10);
 const float ETHPhysicsSimulator::DEFAULT_SCALE(50.0f);
+const unsigned int ETHPhysicsSimulator::DEFAULT_MAX_SUB_STEPS(5);
 int32 ETHPhysicsSimulator::m_velocityIterations(5);
 int32 ETHPhysicsSimulator::m_positionIterations(2);
+ETHShapeCache ETHPhysicsSimulator::m_shapeCache;
 
 std::vector<b2Shape*> ETHPhysicsSimulator::GetBoxShape(const ETHCollisionBox& box, const float angle)
 {
@@ -79,23 +81,8 @@ b2Body* ETHPhysicsSimulator::CreateBody(ETHEntity *entity, const boost::shared_p
 
 	b2Body* body = world->CreateBody(&bodyDef);
 
-	std::vector<b2Shape*> shapes;
-	switch (entity->GetShape())
-	{
-	case ETHBS_CIRCLE:
-		shapes = GetCircleShape(box);
-		break;
-	case ETHBS_POLYGON:
-		shapes = GetPolygonShape(box, entity->GetPolygon());
-		break;
-	case ETHBS_COMPOUND:
-		shapes = entity->GetCompoundShape()->GetShapes(ETHGlobal::ToVector2(box.size));
-		break;
-	case ETHBS_BOX:
-	default:
-		shapes = GetBoxShape(box);
-		break;
-	}
+	const std::vector<b2Shape*>& shapes = m_shapeCache.GetShapes(entity->GetShape(), box,
+		entity->GetPolygon(), entity->GetCompoundShape());
 
 	if (!shapes.empty())
 	{
@@ -108,9 +95,7 @@ b2Body* ETHPhysicsSimulator::CreateBody(ETHEntity *entity, const boost::shared_p
 			fixtureDef.isSensor = entity->IsSensor();
 			fixtureDef.restitution = entity->GetDefaultRestitutionValue();
 			body->CreateFixture(&fixtureDef);
-			delete shapes[t];
 		}
-		shapes.clear();
 		return body;
 	}
 	else
@@ -125,38 +110,303 @@ ETHPhysicsSimulator::ETHPhysicsSimulator(ETHGlobalScaleManagerPtr globalScaleMan
 	m_fixedTimeStepValue(1.0f / 60.0f),
 	m_dynamicTimeStep(1.0f / currentFpsRate),
 	m_timeStepUpdateTime(0.0f),
+	m_accumulateTimeStep(false),
+	m_accumulator(0.0f),
+	m_maxSubSteps(DEFAULT_MAX_SUB_STEPS),
+	m_interpolationAlpha(1.0f),
+	m_asyncStepping(false),
+	m_hasPendingStep(false),
+	m_pendingStepTime(0),
+	m_syncAllTransforms(true),
+	m_sleepListener(0),
+	m_lastSnapshotID(0),
+	m_lastQueryFilterID(0),
 	m_globalScaleManager(globalScaleManager)
 {
 	const bool doSleep = true; // just making it more readable
 	m_world = boost::shared_ptr<b2World>(new b2World((m_globalScaleManager->GetScale()) * DEFAULT_GRAVITY, doSleep));
 	m_world->SetContactListener(&m_contactListener);
 	m_world->SetDestructionListener(&m_destructionListener);
+	m_stepJob.simulator = this;
+	m_stepJob.elapsedTime = 0;
+	m_stepGuard = ETHPhysicsStepGuardPtr(new ETHPhysicsStepGuard(this));
 }
 
 
 ETHPhysicsSimulator::~ETHPhysicsSimulator()
 {
+	m_worker.Wait();
+	m_stepGuard->Detach(); // controllers may outlive the simulator
+	m_world->SetTaskExecutor(NULL);
+	m_world->SetContactListener(NULL);
 	m_world->SetDestructionListener(NULL);
 	m_world.reset();
+	ClearShapeCache();
+}
+
+void ETHPhysicsSimulator::ClearShapeCache()
+{
+	m_shapeCache.Clear();
 }
 
 ETHPhysicsEntityControllerPtr ETHPhysicsSimulator::CreatePhysicsController(ETHEntity *entity, asIScriptModule* module, asIScriptContext* context)
 {
-	return CreatePhysicsController(entity, m_world, module, context);
+	WaitForAsyncStep();
+	ETHPhysicsEntityControllerPtr controller = CreatePhysicsController(entity, m_world, m_stepGuard, module, context);
+	controller->SetUsePublishedTransform(m_asyncStepping);
+	return controller;
 }
 
-ETHPhysicsEntityControllerPtr ETHPhysicsSimulator::CreatePhysicsController(
-	ETHEntity *entity, const boost::shared_ptr<b2World>& world, asIScriptModule* module, asIScriptContext* context)
+ETHPhysicsEntityControllerPtr ETHPhysicsSimulator::CreatePhysicsController(ETHEntity *entity, const boost::shared_ptr<b2World>& world,
+	const ETHPhysicsStepGuardPtr& stepGuard, asIScriptModule* module, asIScriptContext* context)
 {
 	b2Body *body = CreateBody(entity, world);
-	return ETHPhysicsEntityControllerPtr(new ETHPhysicsEntityController(entity->GetController(), body, world, module, context));
+	return ETHPhysicsEntityControllerPtr(new ETHPhysicsEntityController(entity->GetController(), body, world, stepGuard, module, context));
+}
+
+void ETHPhysicsSimulator::STEP_JOB::Execute()
+{
+	simulator->Step(elapsedTime);
+}
+
+void ETHPhysicsSimulator::Update(const unsigned long lastFrameElapsedTime, ETHBucketManager& buckets)
+{
+	if (!m_asyncStepping)
+	{
+		if (m_hasPendingStep)
+		{
+			Step(m_pendingStepTime);
+			m_hasPendingStep = false;
+		}
+		Step(lastFrameElapsedTime);
+		m_contactListener.RetainContacts();
+	}
+	else
+	{
+		WaitForAsyncStep();
+
+		// nobody started the last step (the scene wasn't rendered?), so run it right here
+		if (m_hasPendingStep)
+		{
+			Step(m_pendingStepTime);
+			FinishAsyncStep();
+		}
+		m_pendingStepTime = lastFrameElapsedTime;
+		m_hasPendingStep = true;
+	}
+
+	// entities must be where their bodies are by the time contact callbacks run
+	SyncTransforms(buckets);
+	m_contactListener.DispatchContacts();
+}
+
+void ETHPhysicsSimulator::SyncTransforms(ETHBucketManager& buckets)
+{
+	for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext())
+	{
+		if (body->GetType() == b2_staticBody)
+			continue;
+
+		ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
+		if (!entity)
+			continue;
+
+		ETHPhysicsEntityController* controller = static_cast<ETHPhysicsEntityController*>(entity->GetController().get());
+		if (!m_syncAllTransforms && !body->IsAwake() && controller->IsTransformSettled())
+			continue;
+
+		controller->SyncTransform(buckets);
+
+		const bool asleep = controller->IsTransformSettled();
+		if (m_sleepListener && asleep != controller->IsSleepReported())
+		{
+			controller->SetSleepReported(asleep);
+			if (asleep)
+				m_sleepListener->BodyFellAsleep(entity);
+			else
+				m_sleepListener->BodyWokeUp(entity);
+		}
+	}
+	m_syncAllTransforms = false;
+}
+
+void ETHPhysicsSimulator::SetSleepListener(ETHBodySleepListener* listener)
+{
+	m_sleepListener = listener;
+	m_destructionListener.SetSleepListener(listener);
+}
+
+void ETHPhysicsSimulator::StartAsyncStep()
+{
+	if (!m_asyncStepping || !m_hasPendingStep)
+		return;
+
+	m_hasPendingStep = false;
+	m_stepJob.elapsedTime = m_pendingStepTime;
+	m_worker.Run(&m_stepJob);
+}
+
+void ETHPhysicsSimulator::WaitForAsyncStep()
+{
+	if (!m_worker.IsBusy())
+		return;
+	m_worker.Wait();
+	FinishAsyncStep();
+}
+
+void ETHPhysicsSimulator::FinishAsyncStep()
+{
+	// back on the main thread, so the entities recorded by the contact listener can be referenced
+	m_contactListener.RetainContacts();
+
+	for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext())
+	{
+		if (body->GetType() == b2_staticBody)
+			continue;
+
+		ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
+		if (entity)
+			static_cast<ETHPhysicsEntityController*>(entity->GetController().get())->PublishTransform();
+	}
+}
+
+void ETHPhysicsSimulator::SetAsyncStepping(const bool enable)
+{
+	if (m_asyncStepping == enable)
+		return;
+
+	// a step that is still pending will be run by the next Update
+	if (!enable)
+		WaitForAsyncStep();
+	m_asyncStepping = enable;
+	SetUsePublishedTransforms(enable);
+	m_syncAllTransforms = true;
+}
+
+void ETHPhysicsSimulator::SetNumSolverThreads(const unsigned int numThreads)
+{
+	// more threads than processors would only make the islands wait for each other
+	const unsigned int clampedThreads = Min(Max(numThreads, 1u), ETHWorkerThread::GetNumProcessors());
+	if (clampedThreads == GetNumSolverThreads())
+		return;
+
+	// the executor can't be replaced while a step is running
+	WaitForAsyncStep();
+	m_world->SetTaskExecutor(NULL);
+	m_solverExecutor.reset();
+	if (clampedThreads > 1)
+	{
+		m_solverExecutor = ETHPhysicsTaskExecutorPtr(new ETHPhysicsTaskExecutor(clampedThreads));
+		m_world->SetTaskExecutor(m_solverExecutor.get());
+	}
+}
+
+unsigned int ETHPhysicsSimulator::GetNumSolverThreads() const
+{
+	return (m_solverExecutor.get() != 0) ? static_cast<unsigned int>(m_solverExecutor->GetThreadCount()) : 1;
+}
+
+unsigned int ETHPhysicsSimulator::SaveSnapshot()
+{
+	WaitForAsyncStep();
+	ETHPhysicsSnapshotPtr snapshot(new ETHPhysicsSnapshot);
+	snapshot->Capture(m_world.get(), m_accumulator);
+	m_snapshots[++m_lastSnapshotID] = snapshot;
+	return m_lastSnapshotID;
+}
+
+bool ETHPhysicsSimulator::RestoreSnapshot(const unsigned int snapshot)
+{
+	std::map<unsigned int, ETHPhysicsSnapshotPtr>::iterator iter = m_snapshots.find(snapshot);
+	if (iter == m_snapshots.end())
+		return false;
+
+	WaitForAsyncStep();
+	if (!iter->second->Restore(m_world.get(), m_accumulator))
+		return false;
+
+	// the bodies jumped, so there's nothing to interpolate from
+	UpdateInterpolation(true);
+	// republish so the renderer won't draw the bodies where they were before restoring
+	if (m_asyncStepping)
+		SetUsePublishedTransforms(true);
+
+	// sleeping bodies may have been moved too
+	m_syncAllTransforms = true;
+	return true;
 }
 
-void ETHPhysicsSimulator::Update(const unsigned long lastFrameElapsedTime)
+bool ETHPhysicsSimulator::DeleteSnapshot(const unsigned int snapshot)
 {
+	return (m_snapshots.erase(snapshot) > 0);
+}
+
+bool ETHPhysicsSimulator::IsAsyncStepping() const
+{
+	return m_asyncStepping;
+}
+
+void ETHPhysicsSimulator::SetUsePublishedTransforms(const bool use)
+{
+	for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext())
+	{
+		ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
+		if (entity)
+			static_cast<ETHPhysicsEntityController*>(entity->GetController().get())->SetUsePublishedTransform(use);
+	}
+}
+
+void ETHPhysicsSimulator::Step(const unsigned long lastFrameElapsedTime)
+{
+	m_contactListener.BeginStep();
 	m_dynamicTimeStep = (static_cast<float32>(lastFrameElapsedTime) / 1000.0f);
-	const float step = (!m_fixedTimeStep) ? m_dynamicTimeStep : m_fixedTimeStepValue;
-	m_world->Step(step * m_timeStepScale, m_velocityIterations, m_positionIterations);
+	if (!m_fixedTimeStep || !m_accumulateTimeStep || m_fixedTimeStepValue <= 0.0f)
+	{
+		const float step = (!m_fixedTimeStep) ? m_dynamicTimeStep : m_fixedTimeStepValue;
+		m_world->Step(step * m_timeStepScale, m_velocityIterations, m_positionIterations);
+		m_contactListener.EndStep();
+		return;
+	}
+
+	// run as many fixed steps as the elapsed time asks for. If we are too late to
+	// catch up, drop the remaining time instead of spiraling into ever longer frames
+	m_accumulator += m_dynamicTimeStep * m_timeStepScale;
+	unsigned int numSteps = static_cast<unsigned int>(m_accumulator / m_fixedTimeStepValue);
+	if (numSteps > m_maxSubSteps)
+	{
+		numSteps = m_maxSubSteps;
+		m_accumulator = static_cast<float>(numSteps) * m_fixedTimeStepValue;
+	}
+	m_accumulator -= static_cast<float>(numSteps) * m_fixedTimeStepValue;
+	m_interpolationAlpha = Min(Max(m_accumulator / m_fixedTimeStepValue, 0.0f), 1.0f);
+
+	for (unsigned int t = 0; t < numSteps; t++)
+	{
+		// bodies are drawn between the last two steps, so that's the transform we need to keep
+		if (t == numSteps - 1)
+			UpdateInterpolation(true);
+		m_world->Step(m_fixedTimeStepValue, m_velocityIterations, m_positionIterations);
+	}
+
+	if (numSteps == 0)
+		UpdateInterpolation(false);
+	m_contactListener.EndStep();
+}
+
+void ETHPhysicsSimulator::UpdateInterpolation(const bool storePreviousTransforms)
+{
+	for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext())
+	{
+		if (body->GetType() == b2_staticBody)
+			continue;
+
+		ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
+		if (!entity)
+			continue;
+
+		ETHPhysicsEntityController* controller = static_cast<ETHPhysicsEntityController*>(entity->GetController().get());
+		controller->SetInterpolation(m_interpolationAlpha, storePreviousTransforms);
+	}
 }
 
 float ETHPhysicsSimulator::GetCurrentDynamicTimeStepMS() const
@@ -209,6 +459,7 @@ Vector2 ETHPhysicsSimulator::GetGravity(const boost::shared_ptr<b2World>& world)
 
 void ETHPhysicsSimulator::SetGravity(const Vector2& gravity)
 {
+	WaitForAsyncStep();
 	SetGravity(gravity * m_globalScaleManager->GetScale(), m_world);
 }
 
@@ -219,6 +470,7 @@ Vector2 ETHPhysicsSimulator::GetGravity() const
 
 void ETHPhysicsSimulator::SetTimeStepScale(const float scale)
 {
+	WaitForAsyncStep();
 	m_timeStepScale = scale;
 }
 
@@ -231,32 +483,111 @@ ETHEntity* ETHPhysicsSimulator::GetClosestContact(const Vector2& a, const Vector
 {
 	if (a == b)
 		return 0;
+	WaitForAsyncStep();
 	ETHEntityDefaultChooser chooser;
-	ETHRayCastCallback rayCastCallback(a, b, &chooser);
-	m_world->RayCast(&rayCastCallback, rayCastCallback.GetScaledA(), rayCastCallback.GetScaledB());
-	return rayCastCallback.GetClosestContact(point, normal);
+	ETHClosestRayCastCallback rayCastCallback(&chooser);
+	m_world->RayCast(&rayCastCallback, ScaleToBox2D(a), ScaleToBox2D(b));
+	ETHEntity* entity = rayCastCallback.GetClosestContact(point, normal);
+	if (entity)
+		entity->AddRef();
+	return entity;
 }
 
 ETHEntity* ETHPhysicsSimulator::GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal, const str_type::string& semicolonSeparatedIgnoreList)
 {
 	if (a == b)
 		return 0;
+	WaitForAsyncStep();
 	ETHEntityNameArrayChooser chooser(semicolonSeparatedIgnoreList, true);
-	ETHRayCastCallback rayCastCallback(a, b, &chooser);
-	m_world->RayCast(&rayCastCallback, rayCastCallback.GetScaledA(), rayCastCallback.GetScaledB());
-	return rayCastCallback.GetClosestContact(point, normal);
+	ETHClosestRayCastCallback rayCastCallback(&chooser);
+	m_world->RayCast(&rayCastCallback, ScaleToBox2D(a), ScaleToBox2D(b));
+	ETHEntity* entity = rayCastCallback.GetClosestContact(point, normal);
+	if (entity)
+		entity->AddRef();
+	return entity;
 }
 
 bool ETHPhysicsSimulator::GetContactEntities(const Vector2& a, const Vector2& b, ETHEntityArray& entities)
 {
 	if (a == b)
 		return false;
+	WaitForAsyncStep();
 	ETHEntityDefaultChooser chooser;
 	ETHRayCastCallback rayCastCallback(a, b, &chooser);
 	m_world->RayCast(&rayCastCallback, rayCastCallback.GetScaledA(), rayCastCallback.GetScaledB());
 	return rayCastCallback.GetContactEntities(entities);
 }
 
+unsigned int ETHPhysicsSimulator::CreateQueryFilter(const str_type::string& semicolonSeparatedIgnoreList)
+{
+	m_queryFilters[++m_lastQueryFilterID] = ETHEntityIgnoreFilterPtr(new ETHEntityIgnoreFilter(semicolonSeparatedIgnoreList));
+	return m_lastQueryFilterID;
+}
+
+bool ETHPhysicsSimulator::IgnoreEntityInQueryFilter(const unsigned int filter, const int entityID)
+{
+	std::map<unsigned int, ETHEntityIgnoreFilterPtr>::iterator iter = m_queryFilters.find(filter);
+	if (iter == m_queryFilters.end())
+		return false;
+	iter->second->IgnoreID(entityID);
+	return true;
+}
+
+bool ETHPhysicsSimulator::DestroyQueryFilter(const unsigned int filter)
+{
+	return (m_queryFilters.erase(filter) > 0);
+}
+
+const ETHEntityChooser* ETHPhysicsSimulator::GetQueryFilter(const unsigned int filter) const
+{
+	std::map<unsigned int, ETHEntityIgnoreFilterPtr>::const_iterator iter = m_queryFilters.find(filter);
+	return (iter != m_queryFilters.end()) ? iter->second.get() : 0;
+}
+
+std::size_t ETHPhysicsSimulator::CastRays(const Vector2* a, const Vector2* b, const std::size_t numRays,
+	ETHEntity** hits, Vector2* points, Vector2* normals, const unsigned int filter)
+{
+	WaitForAsyncStep();
+	ETHEntityDefaultChooser defaultChooser;
+	const ETHEntityChooser* chooser = GetQueryFilter(filter);
+	ETHClosestRayCastCallback callback(chooser ? chooser : &defaultChooser);
+
+	std::size_t numHits = 0;
+	for (std::size_t t = 0; t < numRays; t++)
+	{
+		callback.Reset();
+		if (a[t] != b[t])
+			m_world->RayCast(&callback, ScaleToBox2D(a[t]), ScaleToBox2D(b[t]));
+
+		hits[t] = callback.GetClosestContact(points[t], normals[t]);
+		if (hits[t])
+			++numHits;
+	}
+	return numHits;
+}
+
+std::size_t ETHPhysicsSimulator::QueryAABBs(const Vector2* min, const Vector2* max, const std::size_t numBoxes,
+	ETHEntityArray& entities, unsigned int* counts, const unsigned int filter)
+{
+	WaitForAsyncStep();
+	ETHEntityDefaultChooser defaultChooser;
+	const ETHEntityChooser* chooser = GetQueryFilter(filter);
+	ETHAABBQueryCallback callback(chooser ? chooser : &defaultChooser);
+
+	std::size_t total = 0;
+	for (std::size_t t = 0; t < numBoxes; t++)
+	{
+		b2AABB aabb;
+		aabb.lowerBound = ScaleToBox2D(Vector2(Min(min[t].x, max[t].x), Min(min[t].y, max[t].y)));
+		aabb.upperBound = ScaleToBox2D(Vector2(Max(min[t].x, max[t].x), Max(min[t].y, max[t].y)));
+		callback.Reset(aabb, &entities);
+		m_world->QueryAABB(&callback, aabb);
+		counts[t] = callback.GetNumEntities();
+		total += counts[t];
+	}
+	return total;
+}
+
 bool ETHPhysicsSimulator::IsFixedTimeStep() const
 {
 	return m_fixedTimeStep;
@@ -269,14 +600,50 @@ float ETHPhysicsSimulator::GetFixedTimeStepValue() const
 
 void ETHPhysicsSimulator::SetFixedTimeStep(const bool enable)
 {
+	WaitForAsyncStep();
 	m_fixedTimeStep = enable;
 }
 
 void ETHPhysicsSimulator::SetFixedTimeStepValue(const float value)
 {
+	WaitForAsyncStep();
 	m_fixedTimeStepValue = value;
 }
 
+bool ETHPhysicsSimulator::IsTimeStepAccumulated() const
+{
+	return m_accumulateTimeStep;
+}
+
+void ETHPhysicsSimulator::SetTimeStepAccumulation(const bool enable)
+{
+	if (m_accumulateTimeStep == enable)
+		return;
+	WaitForAsyncStep();
+	m_accumulateTimeStep = enable;
+	m_accumulator = 0.0f;
+
+	// bodies must be drawn where they really are while not interpolating
+	m_interpolationAlpha = 1.0f;
+	UpdateInterpolation(true);
+}
+
+unsigned int ETHPhysicsSimulator::GetMaxSubSteps() const
+{
+	return m_maxSubSteps;
+}
+
+void ETHPhysicsSimulator::SetMaxSubSteps(const unsigned int maxSubSteps)
+{
+	WaitForAsyncStep();
+	m_maxSubSteps = Max(maxSubSteps, 1u);
+}
+
+float ETHPhysicsSimulator::GetInterpolationAlpha() const
+{
+	return m_interpolationAlpha;
+}
+
 ETH_BODY_SHAPE ETHPhysicsSimulator::StringToShape(const gs2d::str_type::string& str)
 {
 	if (str == GS_L("box"))
@@ -293,11 +660,13 @@ ETH_BODY_SHAPE ETHPhysicsSimulator::StringToShape(const gs2d::str_type::string&
 
 b2Joint* ETHPhysicsSimulator::CreateJoint(b2JointDef& jointDef)
 {
+	WaitForAsyncStep();
 	return m_world->CreateJoint(&jointDef);
 }
 
 void ETHPhysicsSimulator::ResolveJoints(ETHEntityArray& entities)
 {
+	WaitForAsyncStep();
 	const unsigned int numEntities = entities.size();
 	for (unsigned int t = 0; t < numEntities; t++)
 	{
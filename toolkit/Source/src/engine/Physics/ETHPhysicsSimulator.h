@@ -25,7 +25,14 @@
 
 #include "ETHPhysicsEntityController.h"
 #include "ETHDestructionListener.h"
+#include "ETHShapeCache.h"
+#include "ETHPhysicsTaskExecutor.h"
+#include "ETHPhysicsSnapshot.h"
+#include "ETHPhysicsStepGuard.h"
 #include "../Util/ETHGlobalScaleManager.h"
+#include "../Util/ETHWorkerThread.h"
+#include "../Entity/ETHEntityChooser.h"
+#include <map>
 
 using namespace gs2d::math;
 using namespace gs2d;
@@ -37,16 +44,52 @@ class ETHPhysicsSimulator
 
 	const static b2Vec2 DEFAULT_GRAVITY;
 	const static float  DEFAULT_SCALE;
+	const static unsigned int DEFAULT_MAX_SUB_STEPS;
 	static int32 m_velocityIterations;
 	static int32 m_positionIterations;
+	static ETHShapeCache m_shapeCache;
 	float m_timeStepScale;
 	float m_dynamicTimeStep;
 	bool m_fixedTimeStep;
 	float m_fixedTimeStepValue;
 	float m_timeStepUpdateTime;
+	bool m_accumulateTimeStep;
+	float m_accumulator;
+	unsigned int m_maxSubSteps;
+	float m_interpolationAlpha;
 	ETHDestructionListener m_destructionListener;
 	ETHGlobalScaleManagerPtr m_globalScaleManager;
 
+	struct STEP_JOB : public ETHWorkerThread::Job
+	{
+		ETHPhysicsSimulator* simulator;
+		unsigned long elapsedTime;
+		void Execute();
+	};
+
+	bool m_asyncStepping;
+	bool m_hasPendingStep;
+	unsigned long m_pendingStepTime;
+	STEP_JOB m_stepJob;
+	bool m_syncAllTransforms;
+	ETHBodySleepListener* m_sleepListener;
+	ETHWorkerThread m_worker;
+	ETHPhysicsStepGuardPtr m_stepGuard;
+	ETHPhysicsTaskExecutorPtr m_solverExecutor;
+
+	std::map<unsigned int, ETHPhysicsSnapshotPtr> m_snapshots;
+	unsigned int m_lastSnapshotID;
+
+	std::map<unsigned int, ETHEntityIgnoreFilterPtr> m_queryFilters;
+	unsigned int m_lastQueryFilterID;
+	const ETHEntityChooser* GetQueryFilter(const unsigned int filter) const;
+
+	void Step(const unsigned long lastFrameElapsedTime);
+	void UpdateInterpolation(const bool storePreviousTransforms);
+	void FinishAsyncStep();
+	void SetUsePublishedTransforms(const bool use);
+	void SyncTransforms(ETHBucketManager& buckets);
+
 public:
 	ETHPhysicsSimulator(ETHGlobalScaleManagerPtr globalScaleManager, const float currentFpsRate);
 	~ETHPhysicsSimulator();
@@ -56,11 +99,45 @@ public:
 	static std::vector<b2Shape*> GetPolygonShape(const ETHCollisionBox& box, const ETHPolygonPtr& polygon);
 	static ETH_BODY_SHAPE StringToShape(const gs2d::str_type::string& str);
 
+	/// Releases the shapes CreateBody has kept for reuse
+	static void ClearShapeCache();
+
 	ETHPhysicsEntityControllerPtr CreatePhysicsController(ETHEntity *entity, asIScriptModule* module, asIScriptContext* context);
 	static b2Body* CreateBody(ETHEntity *entity, const boost::shared_ptr<b2World>& world);
 	static ETHPhysicsEntityControllerPtr CreatePhysicsController(ETHEntity *entity, const boost::shared_ptr<b2World>& world,
-		asIScriptModule* module, asIScriptContext* context);
-	void Update(const unsigned long lastFrameElapsedTime);
+		const ETHPhysicsStepGuardPtr& stepGuard, asIScriptModule* module, asIScriptContext* context);
+
+	/// Steps the world and moves the entities of the bodies that are awake to where
+	/// their bodies are. Sleeping bodies are skipped once their entities have caught up
+	void Update(const unsigned long lastFrameElapsedTime, ETHBucketManager& buckets);
+
+	/// The listener is told about bodies falling asleep and waking up as entities are synced
+	void SetSleepListener(ETHBodySleepListener* listener);
+
+	/// In async mode, steps the world in a worker thread while the scene is being rendered.
+	/// Contact callbacks are deferred to the next Update, and entities are moved according
+	/// to the transforms published there
+	void SetAsyncStepping(const bool enable);
+	bool IsAsyncStepping() const;
+
+	/// Hand the step for the current frame over to the worker thread. Must be called after
+	/// all the scripts have run for this frame, since nothing may touch the world until
+	/// WaitForAsyncStep is called. Every method of the simulator and of its entity controllers
+	/// that touches the world waits by itself
+	void StartAsyncStep();
+	void WaitForAsyncStep();
+
+	/// Solve independent body islands in parallel using this many threads. 1 means serial.
+	/// The number is clamped to the number of processors available
+	void SetNumSolverThreads(const unsigned int numThreads);
+	unsigned int GetNumSolverThreads() const;
+
+	/// Keep a copy of the current state of every body and return its ID. Restoring it brings
+	/// the bodies that still exist back to that state without recreating anything
+	unsigned int SaveSnapshot();
+	bool RestoreSnapshot(const unsigned int snapshot);
+	bool DeleteSnapshot(const unsigned int snapshot);
+
 	static b2Vec2 ScaleToBox2D(const Vector2& v);
 	static Vector2 ScaleFromBox2D(const b2Vec2& v);
 	static float32 ScaleToBox2D(const float& v);
@@ -78,10 +155,31 @@ public:
 	float GetFixedTimeStepValue() const;
 	void SetFixedTimeStep(const bool enable);
 	void SetFixedTimeStepValue(const float value);
+	bool IsTimeStepAccumulated() const;
+	void SetTimeStepAccumulation(const bool enable);
+	unsigned int GetMaxSubSteps() const;
+	void SetMaxSubSteps(const unsigned int maxSubSteps);
+	float GetInterpolationAlpha() const;
 	float GetTimeStepScale() const;
 	ETHEntity* GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal);
 	ETHEntity* GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal, const str_type::string& semicolonSeparatedIgnoreList);
 	bool GetContactEntities(const Vector2& a, const Vector2& b, ETHEntityArray& entities);
+
+	/// Ignore filters are precompiled once and then referenced by ID from batched queries.
+	/// ID 0 means no filter at all
+	unsigned int CreateQueryFilter(const str_type::string& semicolonSeparatedIgnoreList);
+	bool IgnoreEntityInQueryFilter(const unsigned int filter, const int entityID);
+	bool DestroyQueryFilter(const unsigned int filter);
+
+	/// Casts the rays a[n]->b[n] and writes the closest hit of each one into hits[n] (not AddRef'd,
+	/// NULL if nothing was hit), points[n] and normals[n]. Returns how many rays hit something
+	std::size_t CastRays(const Vector2* a, const Vector2* b, const std::size_t numRays,
+		ETHEntity** hits, Vector2* points, Vector2* normals, const unsigned int filter);
+
+	/// Appends to entities every entity overlapping each min[n]/max[n] box. counts[n] receives
+	/// the number of entities appended for box n. Returns the total
+	std::size_t QueryAABBs(const Vector2* min, const Vector2* max, const std::size_t numBoxes,
+		ETHEntityArray& entities, unsigned int* counts, const unsigned int filter);
 	void ResolveJoints(ETHEntityArray& entities);
 	b2Joint* CreateJoint(b2JointDef& jointDef);
 };
@@ -0,0 +1,232 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHPhysicsSnapshot.h"
+#include "../Entity/ETHEntity.h"
+#include <string.h>
+
+const unsigned int ETHPhysicsSnapshot::MAGIC_NUMBER(0x53485445); // "ETHS"
+const unsigned int ETHPhysicsSnapshot::VERSION(1);
+
+static int GetEntityID(const b2Body* body)
+{
+	const ETHEntity* entity = static_cast<const ETHEntity*>(body->GetUserData());
+	return entity ? entity->GetID() : -1;
+}
+
+static bool GetFixtureIndex(const b2Fixture* fixture, unsigned short& index)
+{
+	index = 0;
+	for (const b2Fixture* f = fixture->GetBody()->GetFixtureList(); f; f = f->GetNext(), ++index)
+	{
+		if (f == fixture)
+			return true;
+	}
+	return false;
+}
+
+template <class T> void ETHPhysicsSnapshot::Write(const T& value)
+{
+	const std::size_t pos = m_data.size();
+	m_data.resize(pos + sizeof(T));
+	memcpy(&m_data[pos], &value, sizeof(T));
+}
+
+template <class T> bool ETHPhysicsSnapshot::Read(std::size_t& pos, T& value) const
+{
+	if (pos + sizeof(T) > m_data.size())
+	{
+		memset(&value, 0, sizeof(T));
+		return false;
+	}
+	memcpy(&value, &m_data[pos], sizeof(T));
+	pos += sizeof(T);
+	return true;
+}
+
+bool ETHPhysicsSnapshot::CONTACT_KEY::operator<(const CONTACT_KEY& other) const
+{
+	if (idA != other.idA) return idA < other.idA;
+	if (idB != other.idB) return idB < other.idB;
+	if (fixtureA != other.fixtureA) return fixtureA < other.fixtureA;
+	if (fixtureB != other.fixtureB) return fixtureB < other.fixtureB;
+	if (childA != other.childA) return childA < other.childA;
+	return childB < other.childB;
+}
+
+bool ETHPhysicsSnapshot::GetContactKey(b2Contact* contact, CONTACT_KEY& key)
+{
+	key.idA = GetEntityID(contact->GetFixtureA()->GetBody());
+	key.idB = GetEntityID(contact->GetFixtureB()->GetBody());
+	key.childA = contact->GetChildIndexA();
+	key.childB = contact->GetChildIndexB();
+	return (GetFixtureIndex(contact->GetFixtureA(), key.fixtureA) && GetFixtureIndex(contact->GetFixtureB(), key.fixtureB));
+}
+
+void ETHPhysicsSnapshot::Capture(b2World* world, const float timeStepAccumulator)
+{
+	m_data.clear();
+	Write(MAGIC_NUMBER);
+	Write(VERSION);
+	Write(timeStepAccumulator);
+
+	Write(static_cast<unsigned int>(world->GetBodyCount()));
+	for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+	{
+		BODY_STATE state;
+		memset(&state, 0, sizeof(BODY_STATE));
+		state.id = GetEntityID(body);
+		state.posX = body->GetPosition().x;
+		state.posY = body->GetPosition().y;
+		state.angle = body->GetAngle();
+		state.velX = body->GetLinearVelocity().x;
+		state.velY = body->GetLinearVelocity().y;
+		state.angularVel = body->GetAngularVelocity();
+		state.flags = static_cast<unsigned char>((body->IsAwake() ? BF_AWAKE : 0) | (body->IsActive() ? BF_ACTIVE : 0));
+		Write(state);
+	}
+
+	// only the touching contacts carry impulses worth keeping
+	const std::size_t contactCountPos = m_data.size();
+	unsigned int numContacts = 0;
+	Write(numContacts);
+	for (b2Contact* contact = world->GetContactList(); contact; contact = contact->GetNext())
+	{
+		const b2Manifold* manifold = contact->GetManifold();
+		CONTACT_KEY key;
+		if (!contact->IsTouching() || manifold->pointCount == 0 || !GetContactKey(contact, key))
+			continue;
+
+		Write(key);
+		Write(static_cast<unsigned char>(manifold->pointCount));
+		for (int32 t = 0; t < manifold->pointCount; t++)
+		{
+			POINT_STATE point;
+			point.key = manifold->points[t].id.key;
+			point.normalImpulse = manifold->points[t].normalImpulse;
+			point.tangentImpulse = manifold->points[t].tangentImpulse;
+			Write(point);
+		}
+		++numContacts;
+	}
+	memcpy(&m_data[contactCountPos], &numContacts, sizeof(unsigned int));
+}
+
+bool ETHPhysicsSnapshot::Restore(b2World* world, float& timeStepAccumulator) const
+{
+	std::size_t pos = 0;
+	unsigned int magic, version;
+	float accumulator;
+	bool ok = Read(pos, magic) && Read(pos, version) && Read(pos, accumulator);
+	if (!ok || magic != MAGIC_NUMBER || version != VERSION)
+		return false;
+
+	unsigned int numBodies = 0;
+	ok = Read(pos, numBodies);
+	std::vector<BODY_STATE> bodies;
+	for (unsigned int t = 0; t < numBodies && ok; t++)
+	{
+		BODY_STATE state;
+		ok = Read(pos, state);
+		bodies.push_back(state);
+	}
+
+	unsigned int numContacts = 0;
+	ok = ok && Read(pos, numContacts);
+	std::map<CONTACT_KEY, std::vector<POINT_STATE> > contacts;
+	for (unsigned int t = 0; t < numContacts && ok; t++)
+	{
+		CONTACT_KEY key;
+		unsigned char numPoints = 0;
+		ok = Read(pos, key) && Read(pos, numPoints);
+		std::vector<POINT_STATE>& points = contacts[key];
+		points.resize(numPoints);
+		for (std::size_t p = 0; p < points.size() && ok; p++)
+		{
+			ok = Read(pos, points[p]);
+		}
+	}
+
+	if (!ok)
+		return false;
+
+	std::map<int, b2Body*> bodiesById;
+	for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+	{
+		bodiesById[GetEntityID(body)] = body;
+	}
+
+	for (std::size_t t = 0; t < bodies.size(); t++)
+	{
+		const BODY_STATE& state = bodies[t];
+		std::map<int, b2Body*>::iterator iter = bodiesById.find(state.id);
+		if (iter == bodiesById.end())
+			continue;
+
+		b2Body* body = iter->second;
+		body->SetActive((state.flags & BF_ACTIVE) != 0);
+		body->SetTransform(b2Vec2(state.posX, state.posY), state.angle);
+
+		// setting velocities wakes the body up, so the awake state must come last
+		body->SetAwake(true);
+		body->SetLinearVelocity(b2Vec2(state.velX, state.velY));
+		body->SetAngularVelocity(state.angularVel);
+		body->SetAwake((state.flags & BF_AWAKE) != 0);
+	}
+
+	// contacts that still exist get their warm starting impulses back. The next step
+	// matches them against the new manifold points by feature key
+	for (b2Contact* contact = world->GetContactList(); contact; contact = contact->GetNext())
+	{
+		b2Manifold* manifold = contact->GetManifold();
+		CONTACT_KEY key;
+		if (!GetContactKey(contact, key))
+			continue;
+
+		std::map<CONTACT_KEY, std::vector<POINT_STATE> >::const_iterator iter = contacts.find(key);
+		for (int32 t = 0; t < manifold->pointCount; t++)
+		{
+			manifold->points[t].normalImpulse = 0.0f;
+			manifold->points[t].tangentImpulse = 0.0f;
+			if (iter == contacts.end())
+				continue;
+
+			const std::vector<POINT_STATE>& points = iter->second;
+			for (std::size_t p = 0; p < points.size(); p++)
+			{
+				if (points[p].key == manifold->points[t].id.key)
+				{
+					manifold->points[t].normalImpulse = points[p].normalImpulse;
+					manifold->points[t].tangentImpulse = points[p].tangentImpulse;
+				}
+			}
+		}
+	}
+
+	timeStepAccumulator = accumulator;
+	return true;
+}
+
+std::size_t ETHPhysicsSnapshot::GetSize() const
+{
+	return m_data.size();
+}
@@ -0,0 +1,88 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_PHYSICS_SNAPSHOT_H_
+#define ETH_PHYSICS_SNAPSHOT_H_
+
+#include <Box2D/Box2D.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <map>
+
+/// Compact binary copy of the state of every body in a world: transform, velocities and
+/// awake/active flags, plus the warm starting impulses of the touching contacts. Bodies are
+/// matched by entity ID, so it can only be restored into the same scene, in place. Bodies
+/// created after the capture are left untouched and the ones destroyed since are skipped
+class ETHPhysicsSnapshot
+{
+	std::vector<unsigned char> m_data;
+
+	enum BODY_FLAGS
+	{
+		BF_AWAKE = 0x01,
+		BF_ACTIVE = 0x02
+	};
+
+	struct BODY_STATE
+	{
+		int id;
+		float posX, posY, angle;
+		float velX, velY, angularVel;
+		unsigned char flags;
+	};
+
+	struct POINT_STATE
+	{
+		unsigned int key;
+		float normalImpulse, tangentImpulse;
+	};
+
+	template <class T> void Write(const T& value);
+
+	/// Returns false, leaving value zeroed, if there isn't enough data left
+	template <class T> bool Read(std::size_t& pos, T& value) const;
+
+	struct CONTACT_KEY
+	{
+		int idA, idB;
+		unsigned short fixtureA, fixtureB;
+		int childA, childB;
+		bool operator<(const CONTACT_KEY& other) const;
+	};
+	static bool GetContactKey(b2Contact* contact, CONTACT_KEY& key);
+
+public:
+	static const unsigned int MAGIC_NUMBER;
+	static const unsigned int VERSION;
+
+	/// timeStepAccumulator is saved along so fixed steps restart at the same phase
+	void Capture(b2World* world, const float timeStepAccumulator);
+
+	/// Returns false if the data is corrupt. The world is only touched if the whole snapshot could be read
+	bool Restore(b2World* world, float& timeStepAccumulator) const;
+
+	std::size_t GetSize() const;
+};
+
+typedef boost::shared_ptr<ETHPhysicsSnapshot> ETHPhysicsSnapshotPtr;
+
+#endif
@@ -0,0 +1,48 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of this
+	software and associated documentation files (the "Software"), to deal in the
+	Software without restriction, including without limitation the rights to use, copy,
+	modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so, subject to the
+	following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_PHYSICS_STEP_GUARD_H_
+#define ETH_PHYSICS_STEP_GUARD_H_
+
+#include <boost/shared_ptr.hpp>
+
+class ETHPhysicsSimulator;
+
+/// Shared by the simulator with everything that keeps a reference to its world. The world may be
+/// stepping in a worker thread, so bodies and joints may only be touched after calling Wait
+class ETHPhysicsStepGuard
+{
+	ETHPhysicsSimulator* m_simulator;
+
+public:
+	ETHPhysicsStepGuard(ETHPhysicsSimulator* simulator);
+
+	/// Block until the step running in the background (if there's any) is over
+	void Wait();
+
+	/// Called by the simulator when it's destroyed. Wait does nothing from then on
+	void Detach();
+};
+
+typedef boost::shared_ptr<ETHPhysicsStepGuard> ETHPhysicsStepGuardPtr;
+
+#endif
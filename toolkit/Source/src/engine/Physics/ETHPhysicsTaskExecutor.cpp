@@ -0,0 +1,72 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHPhysicsTaskExecutor.h"
+
+void ETHPhysicsTaskExecutor::TASK_JOB::Execute()
+{
+	task->Execute();
+}
+
+ETHPhysicsTaskExecutor::ETHPhysicsTaskExecutor(const unsigned int numThreads)
+{
+	for (unsigned int t = 1; t < numThreads; t++)
+	{
+		boost::shared_ptr<ETHWorkerThread> worker(new ETHWorkerThread);
+
+		// no point in keeping workers that would run the tasks in this thread anyway
+		if (!worker->IsAsynchronous())
+			break;
+		m_workers.push_back(worker);
+	}
+	m_jobs.resize(m_workers.size());
+}
+
+ETHPhysicsTaskExecutor::~ETHPhysicsTaskExecutor()
+{
+	for (std::size_t t = 0; t < m_workers.size(); t++)
+	{
+		m_workers[t]->Wait();
+	}
+}
+
+int32 ETHPhysicsTaskExecutor::GetThreadCount() const
+{
+	return static_cast<int32>(m_workers.size() + 1);
+}
+
+void ETHPhysicsTaskExecutor::Run(b2Task** tasks, int32 count)
+{
+	for (int32 t = 1; t < count; t++)
+	{
+		m_jobs[t - 1].task = tasks[t];
+		m_workers[t - 1]->Run(&m_jobs[t - 1]);
+	}
+
+	if (count > 0)
+		tasks[0]->Execute();
+
+	for (int32 t = 1; t < count; t++)
+	{
+		m_workers[t - 1]->Wait();
+	}
+}
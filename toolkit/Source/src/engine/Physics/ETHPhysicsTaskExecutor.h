@@ -0,0 +1,53 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_PHYSICS_TASK_EXECUTOR_H_
+#define ETH_PHYSICS_TASK_EXECUTOR_H_
+
+#include <Box2D/Box2D.h>
+#include "../Util/ETHWorkerThread.h"
+#include <vector>
+
+/// Runs the island solver tasks of b2World on a small pool of worker threads.
+/// The calling thread always runs the first task itself
+class ETHPhysicsTaskExecutor : public b2TaskExecutor
+{
+	struct TASK_JOB : public ETHWorkerThread::Job
+	{
+		b2Task* task;
+		void Execute();
+	};
+
+	std::vector<boost::shared_ptr<ETHWorkerThread> > m_workers;
+	std::vector<TASK_JOB> m_jobs;
+
+public:
+	ETHPhysicsTaskExecutor(const unsigned int numThreads);
+	~ETHPhysicsTaskExecutor();
+
+	int32 GetThreadCount() const;
+	void Run(b2Task** tasks, int32 count);
+};
+
+typedef boost::shared_ptr<ETHPhysicsTaskExecutor> ETHPhysicsTaskExecutorPtr;
+
+#endif
@@ -85,3 +85,83 @@ b2Vec2 ETHRayCastCallback::GetScaledB() const
 {
 	return m_b;
 }
+
+ETHClosestRayCastCallback::ETHClosestRayCastCallback(const ETHEntityChooser* chooser) :
+	m_chooser(chooser),
+	m_entity(0)
+{
+}
+
+float32 ETHClosestRayCastCallback::ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction)
+{
+	ETHEntity* entity = static_cast<ETHEntity*>(fixture->GetBody()->GetUserData());
+	if (!entity || !m_chooser->Choose(entity))
+		return -1.0f;
+
+	m_entity = entity;
+	m_point = point;
+	m_normal = normal;
+	return fraction;
+}
+
+void ETHClosestRayCastCallback::Reset()
+{
+	m_entity = 0;
+}
+
+ETHEntity* ETHClosestRayCastCallback::GetClosestContact(Vector2& point, Vector2& normal) const
+{
+	if (m_entity)
+	{
+		point = ETHPhysicsSimulator::ScaleFromBox2D(m_point);
+		normal = Vector2(m_normal.x, m_normal.y);
+	}
+	return m_entity;
+}
+
+ETHAABBQueryCallback::ETHAABBQueryCallback(const ETHEntityChooser* chooser) :
+	m_chooser(chooser),
+	m_entities(0),
+	m_first(0)
+{
+}
+
+bool ETHAABBQueryCallback::ReportFixture(b2Fixture* fixture)
+{
+	b2Body* body = fixture->GetBody();
+	ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
+	if (!entity || !m_chooser->Choose(entity))
+		return true;
+
+	// the broad-phase reports fattened boxes, so test the actual shape bounds
+	const b2Shape* shape = fixture->GetShape();
+	bool overlaps = false;
+	for (int32 t = 0; t < shape->GetChildCount() && !overlaps; t++)
+	{
+		b2AABB aabb;
+		shape->ComputeAABB(&aabb, body->GetTransform(), t);
+		overlaps = b2TestOverlap(aabb, m_aabb);
+	}
+	if (!overlaps)
+		return true;
+
+	for (unsigned int t = m_first; t < m_entities->size(); t++)
+	{
+		if ((*m_entities)[t] == entity)
+			return true;
+	}
+	m_entities->push_back(entity);
+	return true;
+}
+
+void ETHAABBQueryCallback::Reset(const b2AABB& aabb, ETHEntityArray* entities)
+{
+	m_aabb = aabb;
+	m_entities = entities;
+	m_first = entities->size();
+}
+
+unsigned int ETHAABBQueryCallback::GetNumEntities() const
+{
+	return m_entities->size() - m_first;
+}
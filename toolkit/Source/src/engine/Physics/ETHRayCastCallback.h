@@ -54,4 +54,39 @@ public:
 	b2Vec2 GetScaledB() const;
 };
 
+/// Only keeps the closest chosen fixture, clipping the ray at each hit so
+/// Box2D can skip everything behind it. Reusable across several rays
+class ETHClosestRayCastCallback : public b2RayCastCallback
+{
+	const ETHEntityChooser* m_chooser;
+	ETHEntity* m_entity;
+	b2Vec2 m_point, m_normal;
+
+public:
+	ETHClosestRayCastCallback(const ETHEntityChooser* chooser);
+	float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction);
+	void Reset();
+
+	/// Returns the closest entity found since the last Reset (not AddRef'd), or NULL
+	ETHEntity* GetClosestContact(Vector2& point, Vector2& normal) const;
+};
+
+/// Collects the entities whose shapes actually overlap the box, each one only once
+/// even if it has many fixtures
+class ETHAABBQueryCallback : public b2QueryCallback
+{
+	const ETHEntityChooser* m_chooser;
+	b2AABB m_aabb;
+	ETHEntityArray* m_entities;
+	unsigned int m_first;
+
+public:
+	ETHAABBQueryCallback(const ETHEntityChooser* chooser);
+	bool ReportFixture(b2Fixture* fixture);
+
+	/// Found entities will be appended to entities
+	void Reset(const b2AABB& aabb, ETHEntityArray* entities);
+	unsigned int GetNumEntities() const;
+};
+
 #endif
\ No newline at end of file
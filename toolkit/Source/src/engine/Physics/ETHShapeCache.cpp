@@ -0,0 +1,114 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHShapeCache.h"
+#include "ETHPhysicsSimulator.h"
+
+const std::size_t ETHShapeCache::MAX_CACHED_SETS(512);
+
+bool ETHShapeCache::SHAPE_KEY::operator<(const SHAPE_KEY& other) const
+{
+	if (shape != other.shape)
+		return (shape < other.shape);
+	if (source != other.source)
+		return (source < other.source);
+	if (posX != other.posX)
+		return (posX < other.posX);
+	if (posY != other.posY)
+		return (posY < other.posY);
+	if (sizeX != other.sizeX)
+		return (sizeX < other.sizeX);
+	return (sizeY < other.sizeY);
+}
+
+ETHShapeCache::SHAPE_SET::~SHAPE_SET()
+{
+	for (std::size_t t = 0; t < shapes.size(); t++)
+	{
+		delete shapes[t];
+	}
+}
+
+const std::vector<b2Shape*>& ETHShapeCache::GetShapes(const ETH_BODY_SHAPE shape, const ETHCollisionBox& box,
+	const ETHPolygonPtr& polygon, const ETHCompoundShapePtr& compoundShape)
+{
+	SHAPE_KEY key;
+	key.shape = shape;
+	key.source = 0;
+	key.posX = box.pos.x;
+	key.posY = box.pos.y;
+	key.sizeX = box.size.x;
+	key.sizeY = box.size.y;
+	if (shape == ETHBS_POLYGON)
+		key.source = polygon.get();
+	else if (shape == ETHBS_COMPOUND)
+		key.source = compoundShape.get();
+
+	std::map<SHAPE_KEY, SHAPE_SET_PTR>::iterator iter = m_sets.find(key);
+	if (iter != m_sets.end())
+		return iter->second->shapes;
+
+	// many different scales (random sized debris, for instance) would make it grow forever
+	if (m_sets.size() >= MAX_CACHED_SETS)
+		Clear();
+
+	SHAPE_SET_PTR set(new SHAPE_SET);
+	std::vector<b2Shape*> shapes;
+	switch (shape)
+	{
+	case ETHBS_CIRCLE:
+		shapes = ETHPhysicsSimulator::GetCircleShape(box);
+		break;
+	case ETHBS_POLYGON:
+		set->polygon = polygon;
+		shapes = ETHPhysicsSimulator::GetPolygonShape(box, polygon);
+		break;
+	case ETHBS_COMPOUND:
+		set->compoundShape = compoundShape;
+		shapes = compoundShape->GetShapes(ETHGlobal::ToVector2(box.size));
+		break;
+	case ETHBS_BOX:
+	default:
+		shapes = ETHPhysicsSimulator::GetBoxShape(box);
+		break;
+	}
+
+	// compound shapes may declare shapes we can't build
+	for (std::size_t t = 0; t < shapes.size(); t++)
+	{
+		if (shapes[t])
+			set->shapes.push_back(shapes[t]);
+	}
+
+	m_sets[key] = set;
+	return set->shapes;
+}
+
+void ETHShapeCache::Clear()
+{
+	m_sets.clear();
+}
+
+std::size_t ETHShapeCache::GetNumCachedSets() const
+{
+	return m_sets.size();
+}
@@ -0,0 +1,66 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_SHAPE_CACHE_H_
+#define ETH_SHAPE_CACHE_H_
+
+#include "ETHCollisionBox.h"
+#include "ETHPolygon.h"
+#include "ETHCompoundShape.h"
+#include <map>
+
+/// Keeps the b2Shapes built for each entity template, body shape and scale, so spawning
+/// the same entity over and over doesn't rebuild (and reparse, for compound shapes) them.
+/// Box2D clones the shape into every fixture, so the cached instances are never modified
+class ETHShapeCache
+{
+	struct SHAPE_KEY
+	{
+		ETH_BODY_SHAPE shape;
+		const void* source;
+		float posX, posY, sizeX, sizeY;
+		bool operator<(const SHAPE_KEY& other) const;
+	};
+
+	struct SHAPE_SET
+	{
+		~SHAPE_SET();
+		std::vector<b2Shape*> shapes;
+
+		// holds the template data so its address can't be reused by another polygon while cached
+		ETHPolygonPtr polygon;
+		ETHCompoundShapePtr compoundShape;
+	};
+	typedef boost::shared_ptr<SHAPE_SET> SHAPE_SET_PTR;
+
+	static const std::size_t MAX_CACHED_SETS;
+	std::map<SHAPE_KEY, SHAPE_SET_PTR> m_sets;
+
+public:
+	/// Returns the shapes for an already scaled collision box. The shapes belong to the cache
+	const std::vector<b2Shape*>& GetShapes(const ETH_BODY_SHAPE shape, const ETHCollisionBox& box,
+		const ETHPolygonPtr& polygon, const ETHCompoundShapePtr& compoundShape);
+	void Clear();
+	std::size_t GetNumCachedSets() const;
+};
+
+#endif
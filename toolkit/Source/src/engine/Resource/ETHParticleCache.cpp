@@ -0,0 +1,66 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHParticleCache.h"
+#include <Platform/Platform.h>
+
+ETHParticleSystemPtr ETHParticleCache::Get(const str_type::string& fullFilePath, const Platform::FileManagerPtr& fileManager)
+{
+	str_type::string fixedPath(fullFilePath);
+	Platform::FixSlashes(fixedPath);
+
+	std::map<str_type::string, ETHParticleSystemPtr>::iterator iter = m_systems.find(fixedPath);
+	if (iter != m_systems.end())
+	{
+		return iter->second;
+	}
+	else
+	{
+		ETHParticleSystemPtr system(new ETH_PARTICLE_SYSTEM);
+		if (system->ReadFromFile(fullFilePath, fileManager))
+		{
+			m_systems[fixedPath] = system;
+			return system;
+		}
+		else
+		{
+			return ETHParticleSystemPtr();
+		}
+	}
+}
+
+void ETHParticleCache::Release(const str_type::string& fullFilePath)
+{
+	str_type::string fixedPath(fullFilePath);
+	Platform::FixSlashes(fixedPath);
+	m_systems.erase(fixedPath);
+}
+
+void ETHParticleCache::ReleaseAll()
+{
+	m_systems.clear();
+}
+
+std::size_t ETHParticleCache::GetNumDefinitions() const
+{
+	return m_systems.size();
+}
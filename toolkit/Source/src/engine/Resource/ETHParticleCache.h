@@ -0,0 +1,48 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_PARTICLE_CACHE_H_
+#define ETH_PARTICLE_CACHE_H_
+
+#include "../ETHParticleManager.h"
+#include <map>
+
+/// Keeps parsed particle system definitions so that loading the same
+/// file again won't touch the file system nor the XML parser.
+/// Definitions handed out by this cache must be treated as immutable.
+class ETHParticleCache
+{
+public:
+	ETHParticleSystemPtr Get(const str_type::string& fullFilePath, const Platform::FileManagerPtr& fileManager);
+
+	/// Forget a definition (useful when its file has been changed on disk)
+	void Release(const str_type::string& fullFilePath);
+	void ReleaseAll();
+	std::size_t GetNumDefinitions() const;
+
+private:
+	std::map<str_type::string, ETHParticleSystemPtr> m_systems;
+};
+
+typedef boost::shared_ptr<ETHParticleCache> ETHParticleCachePtr;
+
+#endif
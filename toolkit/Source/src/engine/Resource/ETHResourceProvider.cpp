@@ -21,6 +21,7 @@
 --------------------------------------------------------------------------------------*/
 
 #include "ETHResourceProvider.h"
+#include "ETHParticleCache.h"
 #include <Platform/Platform.h>
 
 Platform::FileLoggerPtr ETHResourceProvider::m_logger(new Platform::FileLogger(
@@ -63,4 +64,5 @@ str_type::string ETHResourceProvider::m_resourcePath;
 VideoPtr ETHResourceProvider::m_video;
 AudioPtr ETHResourceProvider::m_audio;
 InputPtr ETHResourceProvider::m_input;
-ETHGlobalScaleManagerPtr ETHResourceProvider::m_globalScaleManager(new ETHGlobalScaleManager);
\ No newline at end of file
+ETHGlobalScaleManagerPtr ETHResourceProvider::m_globalScaleManager(new ETHGlobalScaleManager);
+boost::shared_ptr<ETHParticleCache> ETHResourceProvider::m_particleCache(new ETHParticleCache);
@@ -30,6 +30,7 @@
 #include <Platform/FileLogger.h>
 
 class ETHShaderManager;
+class ETHParticleCache;
 
 class ETHResourceProvider
 {
@@ -42,6 +43,7 @@ class ETHResourceProvider
 	static InputPtr m_input;
 	static Platform::FileLoggerPtr m_logger;
 	static ETHGlobalScaleManagerPtr m_globalScaleManager;
+	static boost::shared_ptr<ETHParticleCache> m_particleCache;
 
 public:
 	ETHResourceProvider(ETHGraphicResourceManagerPtr graphicResources, ETHAudioResourceManagerPtr audioResources,
@@ -55,6 +57,7 @@ public:
 	ETH_INLINE ETHGraphicResourceManagerPtr GetGraphicResourceManager() { return m_graphicResources; }
 	ETH_INLINE ETHAudioResourceManagerPtr GetAudioResourceManager() { return m_audioResources; }
 	ETH_INLINE boost::shared_ptr<ETHShaderManager> GetShaderManager() { return m_shaderManager; }
+	ETH_INLINE boost::shared_ptr<ETHParticleCache> GetParticleCache() { return m_particleCache; }
 	ETH_INLINE str_type::string GetProgramPath() { return m_programPath; }
 	ETH_INLINE str_type::string GetResourcePath() { return m_resourcePath; }
 	ETH_INLINE void SetResourcePath(const str_type::string& path) { m_resourcePath = Platform::AddLastSlash(path); }
@@ -24,6 +24,7 @@
 #include "../Entity/ETHEntityArray.h"
 #include "../Entity/ETHRenderEntity.h"
 #include <iostream>
+#include <algorithm>
 
 // Vector2 hash function
 namespace boost {
@@ -39,7 +40,8 @@ inline std::size_t hash_value(Vector2 const& p)
 ETHBucketManager::ETHBucketManager(const ETHResourceProviderPtr& provider, const Vector2& bucketSize, const bool drawingBorderBuckets) :
 	m_bucketSize(bucketSize),
 	m_provider(provider),
-	m_drawingBorderBuckets(drawingBorderBuckets)
+	m_drawingBorderBuckets(drawingBorderBuckets),
+	m_spatialIndex(provider)
 {
 }
 
@@ -130,6 +132,7 @@ void ETHBucketManager::Add(ETHRenderEntity* entity, const SIDE side)
 	{
 		m_entities[bucket].push_back(entity);
 	}
+	m_spatialIndex.Add(entity);
 
 	#ifdef _DEBUG
 	ETH_STREAM_DECL(ss) << GS_L("Entity ") << entity->GetEntityName() << GS_L(" (ID#") << entity->GetID()
@@ -202,116 +205,60 @@ unsigned int ETHBucketManager::GetNumEntities() const
 	return nEntities;
 }
 
-// TODO-TO-DO: this method is too large...
-int ETHBucketManager::SeekEntity(const Vector2 &at, ETHEntity **pOutData, const ETHSceneProperties& props, ETHEntity *pAfterThisOne)
+static bool IsInFront(const ETHRenderEntity* a, const ETHRenderEntity* b)
 {
-	int closestFromBehindID =-1;
-	ETHSpriteEntity *pClosestFromBehind = 0;
+	const float za = a->GetPosition().z, zb = b->GetPosition().z;
+	if (za != zb)
+		return (za > zb);
+	return (a->GetID() > b->GetID());
+}
 
-	//int currentID =-1;
-	//ETHSpriteEntity *pCurrent = 0;
+static bool IsOlder(const ETHRenderEntity* a, const ETHRenderEntity* b)
+{
+	return (a->GetID() < b->GetID());
+}
 
-	int closestFromTheFrontID =-1;
-	ETHSpriteEntity *pClosestFromTheFront = 0;
+int ETHBucketManager::SeekEntity(const Vector2 &at, ETHEntity **pOutData, const ETHSceneProperties& props, ETHEntity *pAfterThisOne)
+{
+	const Vector2 worldPos = at + m_provider->GetVideo()->GetCameraPos();
+	m_queryResults.clear();
+	m_spatialIndex.Query(worldPos, worldPos, m_queryResults);
 
-	if (pAfterThisOne)
+	// keep only the entities the point is really over
+	std::size_t numHits = 0;
+	for (std::size_t t = 0; t < m_queryResults.size(); t++)
 	{
-		ETH_VIEW_RECT rect = pAfterThisOne->GetScreenRect(props);
-		if (at.x < rect.v2Min.x || at.x > rect.v2Max.x ||
-			at.y < rect.v2Min.y || at.y > rect.v2Max.y)
+		const ETH_VIEW_RECT box = m_queryResults[t]->GetScreenRect(props);
+		if (at.x > box.v2Min.x && at.x < box.v2Max.x &&
+			at.y > box.v2Min.y && at.y < box.v2Max.y)
 		{
-			pAfterThisOne = 0;
+			m_queryResults[numHits++] = m_queryResults[t];
 		}
 	}
-
-	if (IsEmpty())
+	if (numHits == 0)
 	{
 		return -1;
 	}
+	m_queryResults.resize(numHits);
+	std::sort(m_queryResults.begin(), m_queryResults.end(), IsInFront);
 
-	std::list<Vector2> buckets;
-	ETHGlobal::GetIntersectingBuckets(buckets, at + m_provider->GetVideo()->GetCameraPos(), Vector2(1,1), GetBucketSize(), true, true);
-
-	// seeks the closest intersecting entity from behind
-	for (std::list<Vector2>::const_reverse_iterator sceneBucketIter = buckets.rbegin();
-		sceneBucketIter != buckets.rend(); sceneBucketIter++)
+	// if pAfterThisOne is over the point too, pick the one right behind it
+	std::size_t chosen = 0;
+	if (pAfterThisOne)
 	{
-		ETHBucketMap::iterator bucketIter = Find(*sceneBucketIter);
-
-		if (bucketIter == GetLastBucket())
-			continue;
-
-		ETHEntityList::const_reverse_iterator iEnd = bucketIter->second.rend();
-		bool escape = false;
-		for (ETHEntityList::reverse_iterator iter = bucketIter->second.rbegin(); iter != iEnd; iter++)
+		for (std::size_t t = 0; t < numHits; t++)
 		{
-			ETHSpriteEntity *pRenderEntity = (*iter);
-			const ETH_VIEW_RECT box = pRenderEntity->GetScreenRect(props);
-
-			if (at.x > box.v2Min.x && at.x < box.v2Max.x &&
-				at.y > box.v2Min.y && at.y < box.v2Max.y)
+			if (m_queryResults[t]->GetID() == pAfterThisOne->GetID())
 			{
-				if (!pAfterThisOne)
-				{
-					if (pOutData)
-						*pOutData = (*iter);
-					return (*iter)->GetID();
-				}
-				else
-				{
-					if (pRenderEntity->GetID() == pAfterThisOne->GetID())
-					{
-						//pCurrent = const_cast<ETHRenderEntity*>(*iter);
-						//currentID = (*iter)->GetID();
-						escape = true;
-						break;
-					}
-				}
-				pClosestFromBehind = const_cast<ETHRenderEntity*>(*iter);
-				closestFromBehindID = pClosestFromBehind->GetID();
-			}
-		}
-		if (escape)
-			break;
-	}
-
-	// seeks the first intersecting entity from the front
-	for (std::list<Vector2>::const_iterator sceneBucketIter = buckets.begin(); sceneBucketIter != buckets.end(); sceneBucketIter++)
-	{
-		ETHBucketMap::iterator bucketIter = Find(*sceneBucketIter);
-
-		if (bucketIter == GetLastBucket())
-			continue;
-
-		ETHEntityList::iterator iter;
-		ETHEntityList::const_iterator iEnd = bucketIter->second.end();
-		bool escape = false;
-		for (iter = bucketIter->second.begin(); iter != iEnd; iter++)
-		{
-			ETHSpriteEntity *pRenderEntity = (*iter);
-			const ETH_VIEW_RECT box = pRenderEntity->GetScreenRect(props);
-
-			if (at.x > box.v2Min.x && at.x < box.v2Max.x &&
-				at.y > box.v2Min.y && at.y < box.v2Max.y)
-			{
-				pClosestFromTheFront = const_cast<ETHRenderEntity*>(*iter);
-				closestFromTheFrontID = pClosestFromTheFront->GetID();
-				escape = true;
+				chosen = (t + 1) % numHits;
 				break;
 			}
 		}
-		if (escape)
-			break;
-	}
-	if (closestFromBehindID >= 0)
-	{
-		if (pOutData && pClosestFromBehind)
-			*pOutData = pClosestFromBehind;
-		return closestFromBehindID;
 	}
-	if (pOutData && pClosestFromTheFront)
-		*pOutData = pClosestFromTheFront;
-	return closestFromTheFrontID;
+
+	if (pOutData)
+		*pOutData = m_queryResults[chosen];
+	return m_queryResults[chosen]->GetID();
 }
 
 ETHSpriteEntity* ETHBucketManager::SeekEntity(const int id)
@@ -359,6 +306,7 @@ bool ETHBucketManager::DeleteEntity(const int id)
 				if (m_entityKillListener)
 					m_entityKillListener->EntityKilled((*iter));
 
+				m_spatialIndex.Remove(id);
 				(*iter)->Kill();
 				(*iter)->Release();
 				bucketIter->second.erase(iter);
@@ -391,6 +339,7 @@ bool ETHBucketManager::DeleteEntity(const int id, const Vector2 &v2SearchBucket,
 
 				if(!stopSfx)
 					(*iter)->SetStopSFXWhenDestroyed(false);
+				m_spatialIndex.Remove(id);
 				(*iter)->Kill();
 				(*iter)->Release();
 				ETHEntityList::iterator i = iter.base();
@@ -500,42 +449,57 @@ void ETHBucketManager::GetVisibleEntities(ETHEntityArray &outVector)
 
 void ETHBucketManager::GetIntersectingEntities(const Vector2 &v2Here, ETHEntityArray &outVector, const bool screenSpace, const ETHSceneProperties& props)
 {
-	ETHEntityArray temp;
-	const Vector2 v2Bucket(ETHGlobal::GetBucket(v2Here, GetBucketSize()));
-
-	// get the main bucket and all buckets around it
-	GetEntityArrayFromBucket(v2Bucket, temp);
-	GetEntityArrayFromBucket(v2Bucket+Vector2(1,0), temp);
-	GetEntityArrayFromBucket(v2Bucket+Vector2(1,1), temp);
-	GetEntityArrayFromBucket(v2Bucket+Vector2(0,1), temp);
-	GetEntityArrayFromBucket(v2Bucket+Vector2(-1,1), temp);
-	GetEntityArrayFromBucket(v2Bucket+Vector2(-1,0), temp);
-	GetEntityArrayFromBucket(v2Bucket+Vector2(-1,-1), temp);
-	GetEntityArrayFromBucket(v2Bucket+Vector2(0,-1), temp);
-	GetEntityArrayFromBucket(v2Bucket+Vector2(1,-1), temp);
-
-	for (unsigned int t=0; t<temp.size(); t++)
+	GetEntitiesInArea(v2Here, v2Here, outVector, screenSpace, props);
+}
+
+void ETHBucketManager::GetEntitiesInArea(const Vector2 &v2Min, const Vector2 &v2Max, ETHEntityArray &outVector, const bool screenSpace, const ETHSceneProperties& props)
+{
+	// accept the corners in any order
+	const Vector2 v2AreaMin(Min(v2Min.x, v2Max.x), Min(v2Min.y, v2Max.y));
+	const Vector2 v2AreaMax(Max(v2Min.x, v2Max.x), Max(v2Min.y, v2Max.y));
+
+	const Vector2& cameraPos = m_provider->GetVideo()->GetCameraPos();
+	m_queryResults.clear();
+	if (screenSpace)
+		m_spatialIndex.Query(v2AreaMin + cameraPos, v2AreaMax + cameraPos, m_queryResults);
+	else
+		m_spatialIndex.Query(v2AreaMin, v2AreaMax, m_queryResults);
+
+	// the tree returns them in no particular order
+	std::sort(m_queryResults.begin(), m_queryResults.end(), IsOlder);
+
+	for (std::size_t t = 0; t < m_queryResults.size(); t++)
 	{
-		ETH_VIEW_RECT rect = temp[t]->GetScreenRect(props);
+		ETH_VIEW_RECT rect = m_queryResults[t]->GetScreenRect(props);
 
 		if (!screenSpace)
 		{
-			rect.v2Max += m_provider->GetVideo()->GetCameraPos();
-			rect.v2Min += m_provider->GetVideo()->GetCameraPos();
+			rect.v2Max += cameraPos;
+			rect.v2Min += cameraPos;
 		}
 
-		if (v2Here.x < rect.v2Min.x)
+		if (v2AreaMax.x < rect.v2Min.x)
 			continue;
-		if (v2Here.y < rect.v2Min.y)
+		if (v2AreaMax.y < rect.v2Min.y)
 			continue;
-		if (v2Here.x > rect.v2Max.x)
+		if (v2AreaMin.x > rect.v2Max.x)
 			continue;
-		if (v2Here.y > rect.v2Max.y)
+		if (v2AreaMin.y > rect.v2Max.y)
 			continue;
-		outVector.push_back(temp[t]);
+		outVector.push_back(m_queryResults[t]);
 	}
 }
 
+void ETHBucketManager::SetSceneProperties(const ETHSceneProperties& props)
+{
+	m_spatialIndex.SetSceneProperties(props);
+}
+
+void ETHBucketManager::UpdateEntityRect(const int id)
+{
+	m_spatialIndex.Update(id);
+}
+
 bool ETHBucketManager::GetEntityArray(ETHEntityArray &outVector)
 {
 	for (ETHBucketMap::iterator bucketIter = GetFirstBucket(); bucketIter != GetLastBucket(); bucketIter++)
@@ -551,6 +515,8 @@ bool ETHBucketManager::GetEntityArray(ETHEntityArray &outVector)
 
 void ETHBucketManager::RequestBucketMove(ETHEntity* target, const Vector2& oldPos, const Vector2& newPos)
 {
+	m_spatialIndex.Update(target->GetID());
+
 	ETHBucketMoveRequest request(target, oldPos, newPos, GetBucketSize());
 	if (request.IsABucketMove())
 	{
@@ -43,6 +43,8 @@ std::size_t hash_value(Vector2 const& p);
 typedef std::list<ETHRenderEntity*> ETHEntityList;
 typedef boost::unordered_map<Vector2, ETHEntityList, boost::hash<Vector2> > ETHBucketMap;
 
+#include "ETHSpatialIndex.h"
+
 class ETHBucketManager
 {
 public:
@@ -78,7 +80,7 @@ public:
 	/// Search for an entity whose location collides with the 'at' point
 	/// It returns the entity ID # and it's further data. If nAfterThisID is greater than
 	/// -1 the entity returned will be another one (if the point collides with more than
-	/// one entities)
+	/// one entities). Entities with a higher z are found first
 	int SeekEntity(const Vector2 &at, ETHEntity **pOutData, const ETHSceneProperties& props, ETHEntity *pAfterThisOne = 0);
 
 	/// Seek the entity by ID #
@@ -105,6 +107,16 @@ public:
 	/// get an array containing all entities that intersect with the point
 	void GetIntersectingEntities(const Vector2 &v2Here, ETHEntityArray &outVector, const bool screenSpace, const ETHSceneProperties& props);
 
+	/// get an array containing all entities whose rects overlap the area
+	void GetEntitiesInArea(const Vector2 &v2Min, const Vector2 &v2Max, ETHEntityArray &outVector, const bool screenSpace, const ETHSceneProperties& props);
+
+	/// Entity rects are kept in a spatial index that must know the scene's z axis direction
+	void SetSceneProperties(const ETHSceneProperties& props);
+
+	/// Recompute the rect the spatial index holds for the entity. Moves are picked up by
+	/// RequestBucketMove, this is for other changes such as scaling
+	void UpdateEntityRect(const int id);
+
 	/// get an array containing all entities in scene
 	bool GetEntityArray(ETHEntityArray &outVector);
 
@@ -139,6 +151,8 @@ private:
 	const Vector2 m_bucketSize;
 	bool m_drawingBorderBuckets;
 	ETHEntityKillListenerPtr m_entityKillListener;
+	ETHSpatialIndex m_spatialIndex;
+	std::vector<ETHRenderEntity*> m_queryResults;
 };
 
 #endif
@@ -26,6 +26,7 @@
 #include "../Shader/ETHShaderManager.h"
 #include "../Resource/ETHResourceProvider.h"
 #include "../Physics/ETHPhysicsSimulator.h"
+#include "../Script/ETHCallbackFunctionCache.h"
 
 #ifdef GS2D_STR_TYPE_WCHAR
 #include "../../addons/utf16/scriptbuilder.h"
@@ -83,6 +84,8 @@ void ETHScene::Init(ETHResourceProviderPtr provider, const ETHSceneProperties& p
 	shaderManager->SetParallaxIntensity(m_sceneProps.parallaxIntensity);
 	m_destructorManager = ETHEntityDestructorManagerPtr(new ETHEntityDestructorManager(pContext));
 	m_buckets.SetDestructionListener(m_destructorManager);
+	m_physicsSimulator.SetSleepListener(&m_tempEntities);
+	m_buckets.SetSceneProperties(m_sceneProps);
 }
 
 void ETHScene::ClearResources()
@@ -179,6 +182,7 @@ bool ETHScene::LoadFromFile(const str_type::string& fileName)
 bool ETHScene::ReadFromXMLFile(TiXmlElement *pRoot)
 {
 	m_sceneProps.ReadFromXMLFile(pRoot);
+	m_buckets.SetSceneProperties(m_sceneProps);
 	TiXmlNode *pNode = pRoot->FirstChild(GS_L("EntitiesInScene"));
 	if (pNode)
 	{
@@ -264,6 +268,7 @@ void ETHScene::SetSceneProperties(const ETHSceneProperties &prop)
 {
 	m_sceneProps = prop;
 	m_provider->GetShaderManager()->SetParallaxIntensity(m_sceneProps.parallaxIntensity);
+	m_buckets.SetSceneProperties(m_sceneProps);
 }
 
 void ETHScene::AddLight(const ETHLight &light)
@@ -369,8 +374,10 @@ bool ETHScene::GenerateLightmaps(const int id)
 
 void ETHScene::Update(const unsigned long lastFrameElapsedTime)
 {
+	// the world may still be stepping since the last frame was rendered, and scripts are about to run
+	m_physicsSimulator.WaitForAsyncStep();
 	m_destructorManager->RunDestructors();
-	m_physicsSimulator.Update(lastFrameElapsedTime);
+	m_physicsSimulator.Update(lastFrameElapsedTime, m_buckets);
 	RunCallbacksFromList();
 }
 
@@ -386,6 +393,9 @@ bool ETHScene::RenderScene(const bool roundUp, const unsigned long lastFrameElap
 
 	float minHeight, maxHeight;
 
+	// all scripts have run for this frame, so the world can be stepped while we render
+	m_physicsSimulator.StartAsyncStep();
+
 	video->SetBlendMode(1, GSBM_ADD);
 
 	video->SetZWrite(GetZBuffer());
@@ -567,6 +577,9 @@ bool ETHScene::RenderList(float &minHeight, float &maxHeight, SpritePtr pOutline
 		{
 			ETHSpriteEntity *pRenderEntity = (*iter);
 
+			// scaling or a moving camera (parallax) may have changed its rect
+			m_buckets.UpdateEntityRect(pRenderEntity->GetID());
+
 			// update scene bounding for depth buffer
 			maxHeight = Max(maxHeight, pRenderEntity->GetMaxHeight());
 			minHeight = Min(minHeight, pRenderEntity->GetMinHeight());
@@ -766,7 +779,6 @@ bool ETHScene::RenderParticleList(std::list<ETHRenderEntity*> &particles)
 		}
 		m_provider->GetShaderManager()->EndParticlePass();
 	}
-	Randomizer::Seed(m_provider->GetVideo()->GetElapsedTime());
 	return true;
 }
 
@@ -784,9 +796,9 @@ void ETHScene::ForceAllSFXStop()
 
 bool ETHScene::AssignCallbackScript(ETHSpriteEntity* entity)
 {
-	const int callbackId = ETHGlobal::FindCallbackFunction(m_pModule, entity, ETH_CALLBACK_PREFIX, *m_provider->GetLogger());
-	const int constructorCallbackId = ETHGlobal::FindCallbackFunction(m_pModule, entity, ETH_CONSTRUCTOR_CALLBACK_PREFIX, *m_provider->GetLogger());
-	const int destructorCallbackId = ETHGlobal::FindCallbackFunction(m_pModule, entity, ETH_DESTRUCTOR_CALLBACK_PREFIX, *m_provider->GetLogger());
+	const int callbackId = ETHCallbackFunctionCache::FindCallbackFunction(m_pModule, entity, ETH_CALLBACK_PREFIX);
+	const int constructorCallbackId = ETHCallbackFunctionCache::FindCallbackFunction(m_pModule, entity, ETH_CONSTRUCTOR_CALLBACK_PREFIX);
+	const int destructorCallbackId = ETHCallbackFunctionCache::FindCallbackFunction(m_pModule, entity, ETH_DESTRUCTOR_CALLBACK_PREFIX);
 	AssignControllerToEntity(entity, callbackId, constructorCallbackId, destructorCallbackId);
 	return true;
 }
@@ -876,6 +888,11 @@ void ETHScene::GetIntersectingEntities(const Vector2 &v2Here, ETHEntityArray &ou
 	m_buckets.GetIntersectingEntities(v2Here, outVector, screenSpace, m_sceneProps);
 }
 
+void ETHScene::GetEntitiesInArea(const Vector2 &v2Min, const Vector2 &v2Max, ETHEntityArray &outVector, const bool screenSpace)
+{
+	m_buckets.GetEntitiesInArea(v2Min, v2Max, outVector, screenSpace, m_sceneProps);
+}
+
 void ETHScene::SetLightIntensity(const float intensity)
 {
 	m_sceneProps.lightIntensity = intensity;
@@ -908,6 +925,7 @@ bool ETHScene::IsDrawingBorderBuckets() const
 void ETHScene::SetZAxisDirection(const Vector2 &v2)
 {
 	m_sceneProps.zAxisDirection = v2;
+	m_buckets.SetSceneProperties(m_sceneProps);
 }
 
 Vector2 ETHScene::GetZAxisDirection() const
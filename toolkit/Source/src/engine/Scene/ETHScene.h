@@ -103,6 +103,7 @@ const Vector2 &v2BucketSize = Vector2(_ETH_DEFAULT_BUCKET_SIZE,_ETH_DEFAULT_BUCK
 	ETHBucketManager& GetBucketManager();
 
 	void GetIntersectingEntities(const Vector2 &v2Here, ETHEntityArray &outVector, const bool screenSpace);
+	void GetEntitiesInArea(const Vector2 &v2Min, const Vector2 &v2Max, ETHEntityArray &outVector, const bool screenSpace);
 
 	unsigned int GetNumEntities() const;
 
@@ -0,0 +1,115 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHSpatialIndex.h"
+#include "../Entity/ETHRenderEntity.h"
+
+const float ETHSpatialIndex::MARGIN(32.0f);
+
+ETHSpatialIndex::ETHSpatialIndex(const ETHResourceProviderPtr& provider) :
+	m_provider(provider)
+{
+}
+
+void ETHSpatialIndex::SetSceneProperties(const ETHSceneProperties& props)
+{
+	const bool zAxisChanged = (props.zAxisDirection != m_props.zAxisDirection);
+	m_props = props;
+	if (!zAxisChanged)
+		return;
+
+	for (boost::unordered_map<int, int32>::iterator iter = m_proxies.begin(); iter != m_proxies.end(); iter++)
+	{
+		Update(iter->first);
+	}
+}
+
+b2AABB ETHSpatialIndex::ComputeAABB(const ETHRenderEntity* entity) const
+{
+	const ETH_VIEW_RECT rect = entity->GetScreenRect(m_props);
+	const Vector2& cameraPos = m_provider->GetVideo()->GetCameraPos();
+	b2AABB aabb;
+	aabb.lowerBound.Set(rect.v2Min.x + cameraPos.x, rect.v2Min.y + cameraPos.y);
+	aabb.upperBound.Set(rect.v2Max.x + cameraPos.x, rect.v2Max.y + cameraPos.y);
+	return aabb;
+}
+
+void ETHSpatialIndex::Add(ETHRenderEntity* entity)
+{
+	if (m_proxies.find(entity->GetID()) != m_proxies.end())
+		return;
+
+	b2AABB aabb = ComputeAABB(entity);
+	aabb.lowerBound -= b2Vec2(MARGIN, MARGIN);
+	aabb.upperBound += b2Vec2(MARGIN, MARGIN);
+	m_proxies[entity->GetID()] = m_tree.CreateProxy(aabb, entity);
+}
+
+void ETHSpatialIndex::Remove(const int id)
+{
+	boost::unordered_map<int, int32>::iterator iter = m_proxies.find(id);
+	if (iter == m_proxies.end())
+		return;
+
+	m_tree.DestroyProxy(iter->second);
+	m_proxies.erase(iter);
+}
+
+void ETHSpatialIndex::Update(const int id)
+{
+	boost::unordered_map<int, int32>::iterator iter = m_proxies.find(id);
+	if (iter == m_proxies.end())
+		return;
+
+	const int32 proxyId = iter->second;
+	const ETHRenderEntity* entity = static_cast<ETHRenderEntity*>(m_tree.GetUserData(proxyId));
+	b2AABB aabb = ComputeAABB(entity);
+	if (m_tree.GetFatAABB(proxyId).Contains(aabb))
+		return;
+
+	aabb.lowerBound -= b2Vec2(MARGIN, MARGIN);
+	aabb.upperBound += b2Vec2(MARGIN, MARGIN);
+	m_tree.MoveProxy(proxyId, aabb, b2Vec2(0.0f, 0.0f));
+}
+
+bool ETHSpatialIndex::QUERY::QueryCallback(int32 proxyId)
+{
+	entities->push_back(static_cast<ETHRenderEntity*>(tree->GetUserData(proxyId)));
+	return true;
+}
+
+void ETHSpatialIndex::Query(const Vector2& min, const Vector2& max, std::vector<ETHRenderEntity*>& outEntities) const
+{
+	b2AABB aabb;
+	aabb.lowerBound.Set(min.x, min.y);
+	aabb.upperBound.Set(max.x, max.y);
+
+	QUERY query;
+	query.tree = &m_tree;
+	query.entities = &outEntities;
+	m_tree.Query(&query, aabb);
+}
+
+std::size_t ETHSpatialIndex::GetNumEntities() const
+{
+	return m_proxies.size();
+}
@@ -0,0 +1,75 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_SPATIAL_INDEX_H_
+#define ETH_SPATIAL_INDEX_H_
+
+#include "ETHSceneProperties.h"
+#include "../Resource/ETHResourceProvider.h"
+#include <Box2D/Box2D.h>
+#include <boost/unordered/unordered_map.hpp>
+#include <vector>
+
+class ETHRenderEntity;
+
+/// Keeps the rect of every entity in the scene, in world space, in a dynamic AABB tree,
+/// so point and area queries don't depend on how many buckets an entity spans.
+/// Rects are enlarged by MARGIN when stored, so small moves don't touch the tree
+class ETHSpatialIndex
+{
+	struct QUERY
+	{
+		const b2DynamicTree* tree;
+		std::vector<ETHRenderEntity*>* entities;
+		bool QueryCallback(int32 proxyId);
+	};
+
+	b2DynamicTree m_tree;
+	boost::unordered_map<int, int32> m_proxies;
+	ETHSceneProperties m_props;
+	ETHResourceProviderPtr m_provider;
+
+	b2AABB ComputeAABB(const ETHRenderEntity* entity) const;
+	ETHSpatialIndex& operator=(const ETHSpatialIndex& p);
+
+public:
+	const static float MARGIN;
+
+	ETHSpatialIndex(const ETHResourceProviderPtr& provider);
+
+	/// Entity rects depend on the z axis direction, so every rect is updated if it changes
+	void SetSceneProperties(const ETHSceneProperties& props);
+
+	void Add(ETHRenderEntity* entity);
+	void Remove(const int id);
+
+	/// Recompute the rect of the entity after it has moved or changed its size
+	void Update(const int id);
+
+	/// Get every entity whose stored (enlarged) rect touches the area. The exact
+	/// rects are left for the caller to test
+	void Query(const Vector2& min, const Vector2& max, std::vector<ETHRenderEntity*>& outEntities) const;
+
+	std::size_t GetNumEntities() const;
+};
+
+#endif
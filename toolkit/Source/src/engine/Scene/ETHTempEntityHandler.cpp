@@ -22,6 +22,7 @@
 
 #include "ETHTempEntityHandler.h"
 #include "../Entity/ETHRenderEntity.h"
+#include "../Entity/ETHEntity.h"
 
 ETHTempEntityHandler::ETHTempEntityHandler(ETHResourceProviderPtr provider) :
 	m_provider(provider)
@@ -34,6 +35,10 @@ ETHTempEntityHandler::~ETHTempEntityHandler()
 	{
 		(*iter)->Release();
 	}
+	for (std::map<int, ETHRenderEntity*>::iterator iter = m_sleepingEntities.begin(); iter != m_sleepingEntities.end(); iter++)
+	{
+		iter->second->Release();
+	}
 	ClearCallbackEntities();
 }
 
@@ -71,6 +76,30 @@ bool ETHTempEntityHandler::IsTempEntityEligible(ETHRenderEntity* entity) const
 	return (((entity->HasAnyCallbackFunction() || entity->HasSimulatedBody()) && !entity->IsStatic()) || entity->IsTemporary());
 }
 
+bool ETHTempEntityHandler::CanSleep(ETHRenderEntity* entity) const
+{
+	return (!entity->HasAnyCallbackFunction() && !entity->HasParticleSystems() && !entity->IsTemporary());
+}
+
+void ETHTempEntityHandler::BodyFellAsleep(ETHEntity* entity)
+{
+	m_fallingAsleep.insert(entity->GetID());
+}
+
+void ETHTempEntityHandler::BodyWokeUp(ETHEntity* entity)
+{
+	const int id = entity->GetID();
+	m_fallingAsleep.erase(id);
+
+	std::map<int, ETHRenderEntity*>::iterator iter = m_sleepingEntities.find(id);
+	if (iter != m_sleepingEntities.end())
+	{
+		// the reference held by the sleeping list goes along with it
+		m_dynamicOrTempEntities.push_back(iter->second);
+		m_sleepingEntities.erase(iter);
+	}
+}
+
 bool ETHTempEntityHandler::AddCallbackWhenEligible(ETHRenderEntity* entity)
 {
 	if (IsCallbackEligible(entity))
@@ -154,15 +183,22 @@ void ETHTempEntityHandler::RunCallbacksFromList()
 			iter = m_dynamicOrTempEntities.erase(iter);
 			continue;
 		}
+		else if (!m_fallingAsleep.empty() && m_fallingAsleep.count((*iter)->GetID()) > 0 && CanSleep(*iter))
+		{
+			m_sleepingEntities[(*iter)->GetID()] = *iter;
+			iter = m_dynamicOrTempEntities.erase(iter);
+			continue;
+		}
 		else
 		{
 			if ((*iter)->HasAnyCallbackFunction())
 			{
-				(*iter)->RunCallbackScript();
+				m_callbackDispatcher.Add(*iter);
 			}
 			iter++;
 		}
 	}
+	m_fallingAsleep.clear();
 
 	for (std::list<ETHRenderEntity*>::iterator iter = m_lastFrameCallbacks.begin(); iter != m_lastFrameCallbacks.end();)
 	{
@@ -180,11 +216,12 @@ void ETHTempEntityHandler::RunCallbacksFromList()
 		{
 			if ((*iter)->HasAnyCallbackFunction())
 			{
-				(*iter)->RunCallbackScript();
+				m_callbackDispatcher.Add(*iter);
 			}
-			(*iter)->Release();
 			iter++;
 		}
 	}
-	m_lastFrameCallbacks.clear();
+
+	m_callbackDispatcher.Dispatch();
+	ClearCallbackEntities();
 }
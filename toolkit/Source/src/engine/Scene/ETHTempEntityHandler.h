@@ -24,8 +24,12 @@
 #define ETH_TEMP_ENTITY_HANDLER_H_
 
 #include "ETHBucketManager.h"
+#include "../Physics/ETHBodySleepListener.h"
+#include "../Script/ETHEntityCallbackDispatcher.h"
+#include <map>
+#include <set>
 
-class ETHTempEntityHandler
+class ETHTempEntityHandler : public ETHBodySleepListener
 {
 public:
 	ETHTempEntityHandler(ETHResourceProviderPtr provider);
@@ -43,9 +47,13 @@ public:
 
 	bool IsCallbackListEmpty() const;
 
+	void BodyFellAsleep(ETHEntity* entity);
+	void BodyWokeUp(ETHEntity* entity);
+
 private:
 	void ClearCallbackEntities();
 	void TestEntityLists() const;
+	bool CanSleep(ETHRenderEntity* entity) const;
 
 	ETHResourceProviderPtr m_provider;
 
@@ -61,6 +69,17 @@ private:
 	 * frame. So we don't have to call them during the rendering iteration
 	 */
 	std::list<ETHRenderEntity*> m_lastFrameCallbacks;
+
+	/*
+	 * Dynamic entities whose bodies have come to rest and that have nothing else
+	 * to do per frame (no callbacks or particles) are kept out of m_dynamicOrTempEntities
+	 * until their bodies wake up. Entities reported asleep are moved here the next
+	 * time the list is iterated
+	 */
+	std::map<int, ETHRenderEntity*> m_sleepingEntities;
+	std::set<int> m_fallingAsleep;
+
+	ETHEntityCallbackDispatcher m_callbackDispatcher;
 };
 
 #endif
\ No newline at end of file
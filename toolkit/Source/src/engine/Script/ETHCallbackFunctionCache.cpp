@@ -0,0 +1,51 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHCallbackFunctionCache.h"
+
+std::map<str_type::string, ETHCallbackFunctionCache::FUNCTION_ID_MAP> ETHCallbackFunctionCache::m_functionIds;
+asIScriptModule* ETHCallbackFunctionCache::m_module = 0;
+
+int ETHCallbackFunctionCache::FindCallbackFunction(asIScriptModule* pModule, const ETHScriptEntity* entity, const str_type::string& prefix)
+{
+	if (pModule != m_module)
+	{
+		Clear();
+		m_module = pModule;
+	}
+
+	FUNCTION_ID_MAP& ids = m_functionIds[prefix];
+	const str_type::string& entityName = entity->GetEntityName();
+	FUNCTION_ID_MAP::const_iterator iter = ids.find(entityName);
+	if (iter != ids.end())
+		return iter->second;
+
+	const int id = ETHGlobal::FindCallbackFunction(pModule, entity, prefix);
+	ids[entityName] = id;
+	return id;
+}
+
+void ETHCallbackFunctionCache::Clear()
+{
+	m_functionIds.clear();
+	m_module = 0;
+}
@@ -0,0 +1,43 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_CALLBACK_FUNCTION_CACHE_H_
+#define ETH_CALLBACK_FUNCTION_CACHE_H_
+
+#include "../Util/ETHASUtil.h"
+#include <map>
+
+/// Keeps the callback function IDs found for each entity name and prefix, so spawning
+/// an entity doesn't search the module by name every time. IDs are only valid for the
+/// module they were found in, so Clear must be called whenever it gets rebuilt
+class ETHCallbackFunctionCache
+{
+	typedef std::map<str_type::string, int> FUNCTION_ID_MAP;
+	static std::map<str_type::string, FUNCTION_ID_MAP> m_functionIds;
+	static asIScriptModule* m_module;
+
+public:
+	static int FindCallbackFunction(asIScriptModule* pModule, const ETHScriptEntity* entity, const str_type::string& prefix);
+	static void Clear();
+};
+
+#endif
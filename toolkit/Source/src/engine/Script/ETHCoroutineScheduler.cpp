@@ -0,0 +1,150 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHCoroutineScheduler.h"
+#include "ETHScriptProfiler.h"
+#include "../Util/ETHASUtil.h"
+#include "../Resource/ETHResourceProvider.h"
+
+const float ETHCoroutineScheduler::DEFAULT_TIME_BUDGET = 4.0f;
+const std::size_t ETHCoroutineScheduler::MAX_POOLED_CONTEXTS = 16;
+
+ETHCoroutineScheduler::ETHCoroutineScheduler() :
+	m_running(0),
+	m_timeBudget(DEFAULT_TIME_BUDGET)
+{
+}
+
+void ETHCoroutineScheduler::SetTimeBudget(const float milliseconds)
+{
+	m_timeBudget = Max(0.0f, milliseconds);
+}
+
+float ETHCoroutineScheduler::GetTimeBudget() const
+{
+	return m_timeBudget;
+}
+
+asIScriptContext* ETHCoroutineScheduler::AcquireContext(asIScriptEngine* engine)
+{
+	if (!m_pool.empty())
+	{
+		asIScriptContext* context = m_pool.back();
+		m_pool.pop_back();
+		return context;
+	}
+	asIScriptContext* context = engine->CreateContext();
+	ETHScriptProfiler::AttachContext(context);
+	return context;
+}
+
+void ETHCoroutineScheduler::ReleaseContext(asIScriptContext* context)
+{
+	// unprepare right away so the coroutine arguments and locals don't wait in the pool to be released
+	context->Unprepare();
+	if (m_pool.size() < MAX_POOLED_CONTEXTS)
+		m_pool.push_back(context);
+	else
+		context->Release();
+}
+
+bool ETHCoroutineScheduler::Start(asIScriptEngine* engine, const int functionId, ETHScriptEntity* entity)
+{
+	asIScriptContext* context = AcquireContext(engine);
+	if (context->Prepare(functionId) < 0 || (entity && context->SetArgObject(0, entity) < 0))
+	{
+		ETH_STREAM_DECL(ss) << GS_L("(ETHCoroutineScheduler::Start) Couldn't prepare coroutine for function ID ") << functionId;
+		ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
+		ReleaseContext(context);
+		return false;
+	}
+
+	COROUTINE coroutine;
+	coroutine.context = context;
+	coroutine.functionId = functionId;
+	m_coroutines.push_back(coroutine);
+	return true;
+}
+
+unsigned int ETHCoroutineScheduler::Resume(const gs2d::VideoPtr& video)
+{
+	const float deadline = video->GetElapsedTimeF() + m_timeBudget;
+
+	// coroutines started by the ones resumed here go to the back of the queue and wait for the next frame
+	std::size_t pending = m_coroutines.size();
+	unsigned int resumed = 0;
+	while (pending > 0)
+	{
+		const COROUTINE coroutine = m_coroutines.front();
+		m_coroutines.pop_front();
+		--pending;
+
+		// a suspended context just carries on from where it stopped, so there's nothing to prepare
+		m_running = coroutine.context;
+		const int r = ETHGlobal::ExecuteContext(coroutine.context, coroutine.functionId, false);
+		m_running = 0;
+		++resumed;
+
+		if (r == asEXECUTION_SUSPENDED)
+			m_coroutines.push_back(coroutine);
+		else
+			ReleaseContext(coroutine.context);
+
+		// checked after resuming, so even overloaded frames make some progress
+		if (video->GetElapsedTimeF() >= deadline)
+			break;
+	}
+	return resumed;
+}
+
+bool ETHCoroutineScheduler::Suspend(asIScriptContext* context)
+{
+	if (!context || context != m_running)
+		return false;
+	return (context->Suspend() >= 0);
+}
+
+std::size_t ETHCoroutineScheduler::GetNumCoroutines() const
+{
+	return m_coroutines.size();
+}
+
+void ETHCoroutineScheduler::AbortAll()
+{
+	while (!m_coroutines.empty())
+	{
+		asIScriptContext* context = m_coroutines.front().context;
+		m_coroutines.pop_front();
+		context->Abort();
+		ReleaseContext(context);
+	}
+}
+
+void ETHCoroutineScheduler::ReleaseContexts()
+{
+	AbortAll();
+	for (std::size_t t = 0; t < m_pool.size(); t++)
+	{
+		m_pool[t]->Release();
+	}
+	m_pool.clear();
+}
@@ -0,0 +1,81 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_COROUTINE_SCHEDULER_H_
+#define ETH_COROUTINE_SCHEDULER_H_
+
+#include "../../angelscript/include/angelscript.h"
+#include "../ETHCommon.h"
+#include <vector>
+#include <deque>
+
+class ETHScriptEntity;
+
+/// Runs script functions as coroutines. Each coroutine gets a context of its own, taken from a pool,
+/// and may suspend itself to be resumed on the next frame. Suspended coroutines are resumed in turns
+/// until the frame time budget runs out, so long jobs such as loading or AI can be spread across frames
+class ETHCoroutineScheduler
+{
+	struct COROUTINE
+	{
+		asIScriptContext* context;
+		int functionId;
+	};
+
+	std::deque<COROUTINE> m_coroutines;
+	std::vector<asIScriptContext*> m_pool;
+	asIScriptContext* m_running;
+	float m_timeBudget;
+
+	asIScriptContext* AcquireContext(asIScriptEngine* engine);
+	void ReleaseContext(asIScriptContext* context);
+
+public:
+	static const float DEFAULT_TIME_BUDGET;
+	static const std::size_t MAX_POOLED_CONTEXTS;
+
+	ETHCoroutineScheduler();
+
+	void SetTimeBudget(const float milliseconds);
+	float GetTimeBudget() const;
+
+	/// Queues the function to start on the next call to Resume. If entity is not null, it is passed
+	/// as the first argument of the function
+	bool Start(asIScriptEngine* engine, const int functionId, ETHScriptEntity* entity);
+
+	/// Resumes the queued coroutines until each one ran once or the time budget runs out, whatever comes first.
+	/// The ones left over go first on the next frame. Returns the number of coroutines resumed
+	unsigned int Resume(const gs2d::VideoPtr& video);
+
+	/// Suspends the context if it's the coroutine currently being resumed. Returns false otherwise
+	bool Suspend(asIScriptContext* context);
+
+	std::size_t GetNumCoroutines() const;
+
+	/// Aborts every coroutine and returns their contexts to the pool
+	void AbortAll();
+
+	/// Aborts every coroutine and releases all pooled contexts. Must be called before the script engine is released
+	void ReleaseContexts();
+};
+
+#endif
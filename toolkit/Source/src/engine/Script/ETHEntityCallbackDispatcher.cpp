@@ -0,0 +1,76 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHEntityCallbackDispatcher.h"
+#include <algorithm>
+
+bool ETHEntityCallbackDispatcher::CALLBACK_CALL::operator<(const CALLBACK_CALL& other) const
+{
+	if (context != other.context)
+		return (context < other.context);
+	if (functionId != other.functionId)
+		return (functionId < other.functionId);
+	return (order < other.order);
+}
+
+void ETHEntityCallbackDispatcher::Add(ETHEntity* entity)
+{
+	const ETHEntityControllerPtr& controller = entity->GetController();
+	if (controller->HasConstructorCallback())
+	{
+		entity->RunCallbackScript();
+		return;
+	}
+
+	const int functionId = controller->GetCallbackId();
+	if (functionId < 0)
+		return;
+
+	CALLBACK_CALL call;
+	call.context = controller->GetScriptContext();
+	call.functionId = functionId;
+	call.order = m_calls.size();
+	call.entity = entity;
+	m_calls.push_back(call);
+}
+
+void ETHEntityCallbackDispatcher::Dispatch()
+{
+	std::sort(m_calls.begin(), m_calls.end());
+
+	for (std::size_t t = 0; t < m_calls.size(); t++)
+	{
+		const CALLBACK_CALL& call = m_calls[t];
+
+		// an earlier callback may have deleted it
+		if (!call.entity->IsAlive())
+			continue;
+
+		// sorting by function lets Prepare skip the work for consecutive calls
+		if (call.context->Prepare(call.functionId) < 0)
+			continue;
+
+		if (call.context->SetArgObject(0, call.entity) >= 0)
+			ETHGlobal::ExecuteContext(call.context, call.functionId, false);
+	}
+	m_calls.clear();
+}
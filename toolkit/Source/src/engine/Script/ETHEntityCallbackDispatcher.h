@@ -0,0 +1,53 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_ENTITY_CALLBACK_DISPATCHER_H_
+#define ETH_ENTITY_CALLBACK_DISPATCHER_H_
+
+#include "../Entity/ETHEntity.h"
+#include <vector>
+
+/// Runs the per-frame callbacks of many entities grouped by function, so the
+/// context is prepared once per function and just executed again for every
+/// other entity that shares it. Exceptions are still reported per entity
+class ETHEntityCallbackDispatcher
+{
+	struct CALLBACK_CALL
+	{
+		asIScriptContext* context;
+		int functionId;
+		std::size_t order;
+		ETHEntity* entity;
+		bool operator<(const CALLBACK_CALL& other) const;
+	};
+
+	std::vector<CALLBACK_CALL> m_calls;
+
+public:
+	/// Queue the callback of the entity. Entities that haven't run their constructor
+	/// callback yet have all their callbacks run right away. The entity must stay
+	/// referenced until Dispatch is called
+	void Add(ETHEntity* entity);
+	void Dispatch();
+};
+
+#endif
@@ -0,0 +1,101 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHGarbageCollectScheduler.h"
+
+const float ETHGarbageCollectScheduler::DEFAULT_TARGET_FRAME_TIME = 1000.0f / 60.0f;
+const float ETHGarbageCollectScheduler::MIN_STEP_TIME = 0.01f;
+const float ETHGarbageCollectScheduler::AVERAGE_WEIGHT = 0.1f;
+const unsigned int ETHGarbageCollectScheduler::MAX_STEPS_PER_FRAME = 256;
+const asUINT ETHGarbageCollectScheduler::MIN_SIZE_FOR_FULL_CYCLE = 4096;
+const asUINT ETHGarbageCollectScheduler::GROWTH_FACTOR_FOR_FULL_CYCLE = 4;
+
+ETHGarbageCollectScheduler::ETHGarbageCollectScheduler() :
+	m_targetFrameTime(DEFAULT_TARGET_FRAME_TIME),
+	m_renderTime(0.0f),
+	m_stepTime(MIN_STEP_TIME),
+	m_sizeAfterFullCycle(0)
+{
+}
+
+void ETHGarbageCollectScheduler::SetTargetFrameTime(const float milliseconds)
+{
+	m_targetFrameTime = milliseconds;
+}
+
+void ETHGarbageCollectScheduler::SetRenderTime(const float milliseconds)
+{
+	// the video timers may have poor resolution, so keep a moving average instead
+	m_renderTime += (milliseconds - m_renderTime) * AVERAGE_WEIGHT;
+}
+
+bool ETHGarbageCollectScheduler::IsGrowingTooFast(asIScriptEngine* engine) const
+{
+	asUINT currentSize = 0;
+	engine->GetGCStatistics(&currentSize);
+	return (currentSize > MIN_SIZE_FOR_FULL_CYCLE && currentSize > m_sizeAfterFullCycle * GROWTH_FACTOR_FOR_FULL_CYCLE);
+}
+
+unsigned int ETHGarbageCollectScheduler::Collect(asIScriptEngine* engine, const gs2d::VideoPtr& video, const float frameStartTime)
+{
+	// the incremental steps can't keep up, so pay for a full cycle once instead of letting it grow further
+	if (IsGrowingTooFast(engine))
+	{
+		RunFullCycle(engine);
+		return 0;
+	}
+
+	const float startTime = video->GetElapsedTimeF();
+	const float budget = m_targetFrameTime - (startTime - frameStartTime) - m_renderTime;
+
+	// always step at least once so the collector makes progress even on overloaded frames
+	unsigned int maxSteps = 1;
+	if (budget > m_stepTime)
+		maxSteps = Min(MAX_STEPS_PER_FRAME, static_cast<unsigned int>(budget / m_stepTime));
+
+	const float deadline = startTime + budget;
+	unsigned int steps = 0;
+	while (steps < maxSteps)
+	{
+		++steps;
+		engine->GarbageCollect(asGC_ONE_STEP);
+
+		// incremental steps never report a finished cycle, so the only early
+		// way out is a collector with nothing left to look at
+		asUINT currentSize = 0;
+		engine->GetGCStatistics(&currentSize);
+		if (currentSize == 0)
+			break;
+		if (video->GetElapsedTimeF() >= deadline)
+			break;
+	}
+
+	const float stepTime = (video->GetElapsedTimeF() - startTime) / static_cast<float>(steps);
+	m_stepTime = Max(MIN_STEP_TIME, m_stepTime + (stepTime - m_stepTime) * AVERAGE_WEIGHT);
+	return steps;
+}
+
+void ETHGarbageCollectScheduler::RunFullCycle(asIScriptEngine* engine)
+{
+	engine->GarbageCollect(asGC_FULL_CYCLE);
+	engine->GetGCStatistics(&m_sizeAfterFullCycle);
+}
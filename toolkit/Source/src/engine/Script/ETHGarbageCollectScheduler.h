@@ -0,0 +1,65 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_GARBAGE_COLLECT_SCHEDULER_H_
+#define ETH_GARBAGE_COLLECT_SCHEDULER_H_
+
+#include "../../angelscript/include/angelscript.h"
+#include "../ETHCommon.h"
+
+/// Spreads the script garbage collection across frames. Each frame gets as many incremental
+/// steps as fit in what is left of the frame budget once update and rendering are accounted for,
+/// and a full cycle only runs when the garbage collector reports heavy growth or when asked to,
+/// e.g. on scene transitions
+class ETHGarbageCollectScheduler
+{
+	float m_targetFrameTime;
+	float m_renderTime;
+	float m_stepTime;
+	asUINT m_sizeAfterFullCycle;
+
+	bool IsGrowingTooFast(asIScriptEngine* engine) const;
+
+public:
+	static const float DEFAULT_TARGET_FRAME_TIME;
+	static const float MIN_STEP_TIME;
+	static const float AVERAGE_WEIGHT;
+	static const unsigned int MAX_STEPS_PER_FRAME;
+	static const asUINT MIN_SIZE_FOR_FULL_CYCLE;
+	static const asUINT GROWTH_FACTOR_FOR_FULL_CYCLE;
+
+	ETHGarbageCollectScheduler();
+
+	void SetTargetFrameTime(const float milliseconds);
+
+	/// Informs how long the last frame took to render, not counting the wait for presentation
+	void SetRenderTime(const float milliseconds);
+
+	/// Runs incremental steps until the frame budget runs out or the collector is empty. frameStartTime is the video elapsed time,
+	/// in milliseconds, when the current frame started updating. Returns the number of steps executed
+	unsigned int Collect(asIScriptEngine* engine, const gs2d::VideoPtr& video, const float frameStartTime);
+
+	/// Detects and destroys all garbage at once
+	void RunFullCycle(asIScriptEngine* engine);
+};
+
+#endif
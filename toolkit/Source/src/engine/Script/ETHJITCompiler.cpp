@@ -0,0 +1,669 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHJITCompiler.h"
+#include <vector>
+#include <cstring>
+
+#ifdef ETH_JIT_COMPILER_ENABLED
+ #include <sys/mman.h>
+#endif
+
+const std::size_t ETHJITCompiler::MAX_ENTRIES = 0xFFFF;
+
+ETHJITCompiler::~ETHJITCompiler()
+{
+	while (!m_functions.empty())
+	{
+		ReleaseJITFunction(m_functions.begin()->first);
+	}
+}
+
+#ifdef ETH_JIT_COMPILER_ENABLED
+
+// Generated functions follow the System V calling convention: rdi holds the asSVMRegisters pointer
+// and esi the entry id. rsi is reused for the stack frame pointer once the entry id has been read.
+// Nothing is called from native code, so only scratch registers are used and no prologue is needed
+typedef std::vector<unsigned char> CODE;
+
+struct JUMP_FIXUP
+{
+	std::size_t codePos;
+	asUINT target;
+};
+
+static const int EAX = 0, ECX = 1, EDX = 2, ESI = 6, EDI = 7;
+static const int XMM0 = 0, XMM1 = 1;
+
+static const int STACK_FRAME_POINTER = static_cast<int>(offsetof(asSVMRegisters, stackFramePointer));
+static const int PROGRAM_POINTER = static_cast<int>(offsetof(asSVMRegisters, programPointer));
+static const int VALUE_REGISTER = static_cast<int>(offsetof(asSVMRegisters, valueRegister));
+static const int DO_PROCESS_SUSPEND = static_cast<int>(offsetof(asSVMRegisters, doProcessSuspend));
+
+// size of the code EmitExit generates
+static const std::size_t EXIT_SIZE = 18;
+
+static void Emit8(CODE& code, const unsigned int value)
+{
+	code.push_back(static_cast<unsigned char>(value));
+}
+
+static void Emit32(CODE& code, const asDWORD value)
+{
+	for (unsigned int t = 0; t < 4; t++)
+		Emit8(code, (value >> (t * 8)) & 0xFF);
+}
+
+static void Emit64(CODE& code, const asQWORD value)
+{
+	Emit32(code, static_cast<asDWORD>(value));
+	Emit32(code, static_cast<asDWORD>(value >> 32));
+}
+
+static void Patch32(CODE& code, const std::size_t pos, const asDWORD value)
+{
+	for (unsigned int t = 0; t < 4; t++)
+		code[pos + t] = static_cast<unsigned char>((value >> (t * 8)) & 0xFF);
+}
+
+/// ModRM byte and displacement for [base + disp32]. base must be rsi or rdi, which need no SIB byte
+static void EmitMem(CODE& code, const int reg, const int base, const int disp)
+{
+	Emit8(code, 0x80 | (reg << 3) | base);
+	Emit32(code, static_cast<asDWORD>(disp));
+}
+
+/// Script variables are addressed in dwords, downwards from the stack frame pointer
+static int Var(const short offset)
+{
+	return -4 * static_cast<int>(offset);
+}
+
+/// opcode reg, [rsi + var], for 32-bit integer instructions
+static void EmitVarOp(CODE& code, const unsigned int opcode, const int reg, const short var)
+{
+	Emit8(code, opcode);
+	EmitMem(code, reg, ESI, Var(var));
+}
+
+/// the REX.W version of EmitVarOp
+static void EmitVarOp64(CODE& code, const unsigned int opcode, const int reg, const short var)
+{
+	Emit8(code, 0x48);
+	EmitVarOp(code, opcode, reg, var);
+}
+
+/// SSE scalar instruction with a variable operand. prefix is 0xF3 for floats and 0xF2 for doubles
+static void EmitSSEVarOp(CODE& code, const unsigned int prefix, const unsigned int opcode, const int xmm, const short var)
+{
+	Emit8(code, prefix);
+	Emit8(code, 0x0F);
+	EmitVarOp(code, opcode, xmm, var);
+}
+
+/// SSE scalar instruction xmm0, xmm1
+static void EmitSSERegOp(CODE& code, const unsigned int prefix, const unsigned int opcode)
+{
+	Emit8(code, prefix);
+	Emit8(code, 0x0F);
+	Emit8(code, opcode);
+	Emit8(code, 0xC0 | (XMM0 << 3) | XMM1);
+}
+
+/// Stores the address of the current instruction as the VM program pointer and returns, so the VM
+/// carries on from that instruction
+static void EmitExit(CODE& code, const asDWORD* bc)
+{
+	Emit8(code, 0x48); Emit8(code, 0xB8); Emit64(code, reinterpret_cast<asQWORD>(bc)); // mov rax, bc
+	Emit8(code, 0x48); Emit8(code, 0x89); EmitMem(code, EAX, EDI, PROGRAM_POINTER); // mov [rdi + programPointer], rax
+	Emit8(code, 0xC3); // ret
+}
+
+/// Short conditional jump over the next 'size' bytes
+static void EmitSkip(CODE& code, const unsigned int jcc, const std::size_t size)
+{
+	Emit8(code, jcc);
+	Emit8(code, static_cast<unsigned int>(size));
+}
+
+/// Conditional (jcc != 0) or unconditional jump to another instruction, resolved once every
+/// instruction has been placed
+static void EmitJump(CODE& code, const unsigned int jcc, const asUINT target, std::vector<JUMP_FIXUP>& fixups)
+{
+	if (jcc)
+	{
+		Emit8(code, 0x0F);
+		Emit8(code, jcc);
+	}
+	else
+	{
+		Emit8(code, 0xE9);
+	}
+	JUMP_FIXUP fixup;
+	fixup.codePos = code.size();
+	fixup.target = target;
+	fixups.push_back(fixup);
+	Emit32(code, 0);
+}
+
+/// eax holds an int, the value register gets -1, 0 or 1 depending on its sign
+static void EmitIntSign(CODE& code)
+{
+	Emit8(code, 0x89); Emit8(code, 0xC2); // mov edx, eax
+	Emit8(code, 0xC1); Emit8(code, 0xFA); Emit8(code, 31); // sar edx, 31
+	Emit8(code, 0x85); Emit8(code, 0xC0); // test eax, eax
+	Emit8(code, 0x0F); Emit8(code, 0x9F); Emit8(code, 0xC0); // setg al
+	Emit8(code, 0x0F); Emit8(code, 0xB6); Emit8(code, 0xC0); // movzx eax, al
+	Emit8(code, 0x09); Emit8(code, 0xD0); // or eax, edx
+	Emit8(code, 0x89); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov [rdi + valueRegister], eax
+}
+
+/// flags hold an unsigned comparison, the value register gets -1, 0 or 1
+static void EmitUnsignedCompareResult(CODE& code)
+{
+	Emit8(code, 0x0F); Emit8(code, 0x97); Emit8(code, 0xC0); // seta al
+	Emit8(code, 0x19); Emit8(code, 0xD2); // sbb edx, edx
+	Emit8(code, 0x0F); Emit8(code, 0xB6); Emit8(code, 0xC0); // movzx eax, al
+	Emit8(code, 0x09); Emit8(code, 0xD0); // or eax, edx
+	Emit8(code, 0x89); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov [rdi + valueRegister], eax
+}
+
+/// xmm0 holds a difference, the value register gets 0 if it is zero, -1 if it is negative and
+/// 1 otherwise, which includes NaN just like the VM
+static void EmitFloatSign(CODE& code, const bool isDouble)
+{
+	Emit8(code, 0x0F); Emit8(code, 0x57); Emit8(code, 0xC9); // xorps xmm1, xmm1
+	if (isDouble)
+		Emit8(code, 0x66);
+	Emit8(code, 0x0F); Emit8(code, 0x2E); Emit8(code, 0xC1); // ucomiss/ucomisd xmm0, xmm1
+	Emit8(code, 0xB8); Emit32(code, 1); // mov eax, 1
+	EmitSkip(code, 0x7A, 16); // jp
+	Emit8(code, 0xB9); Emit32(code, 0); // mov ecx, 0
+	Emit8(code, 0x0F); Emit8(code, 0x44); Emit8(code, 0xC1); // cmove eax, ecx
+	Emit8(code, 0xB9); Emit32(code, 0xFFFFFFFF); // mov ecx, -1
+	Emit8(code, 0x0F); Emit8(code, 0x42); Emit8(code, 0xC1); // cmovb eax, ecx
+	Emit8(code, 0x89); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov [rdi + valueRegister], eax
+}
+
+/// value register int test, stores VALUE_OF_BOOLEAN_TRUE or 0 in the whole register
+static void EmitTest(CODE& code, const unsigned int setcc)
+{
+	Emit8(code, 0x8B); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov eax, [rdi + valueRegister]
+	Emit8(code, 0x85); Emit8(code, 0xC0); // test eax, eax
+	Emit8(code, 0x0F); Emit8(code, setcc); Emit8(code, 0xC0); // setcc al
+	Emit8(code, 0x0F); Emit8(code, 0xB6); Emit8(code, 0xC0); // movzx eax, al
+	Emit8(code, 0x48); Emit8(code, 0x89); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov [rdi + valueRegister], rax
+}
+
+/// jumps to target if the int in the value register satisfies jcc
+static void EmitConditionalJump(CODE& code, const unsigned int jcc, const asUINT target, std::vector<JUMP_FIXUP>& fixups)
+{
+	Emit8(code, 0x8B); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov eax, [rdi + valueRegister]
+	Emit8(code, 0x85); Emit8(code, 0xC0); // test eax, eax
+	EmitJump(code, jcc, target, fixups);
+}
+
+/// var0 = var1 op var2, for ints
+static void EmitIntMath(CODE& code, const asDWORD* bc, const unsigned int opcode)
+{
+	EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG1(bc)); // mov eax, var1
+	if (opcode > 0xFF)
+		Emit8(code, opcode >> 8);
+	EmitVarOp(code, opcode & 0xFF, EAX, asBC_SWORDARG2(bc)); // op eax, var2
+	EmitVarOp(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, eax
+}
+
+/// var0 = var1 op var2, for floats and doubles
+static void EmitFloatMath(CODE& code, const asDWORD* bc, const unsigned int prefix, const unsigned int opcode)
+{
+	EmitSSEVarOp(code, prefix, 0x10, XMM0, asBC_SWORDARG1(bc)); // movss/movsd xmm0, var1
+	EmitSSEVarOp(code, prefix, opcode, XMM0, asBC_SWORDARG2(bc)); // op xmm0, var2
+	EmitSSEVarOp(code, prefix, 0x11, XMM0, asBC_SWORDARG0(bc)); // movss/movsd var0, xmm0
+}
+
+/// var0 = var1 / var2, handing over to the VM when var2 is zero so it raises the script exception
+static void EmitFloatDivision(CODE& code, const asDWORD* bc, const unsigned int prefix)
+{
+	EmitSSEVarOp(code, prefix, 0x10, XMM1, asBC_SWORDARG2(bc)); // movss/movsd xmm1, var2
+	Emit8(code, 0x0F); Emit8(code, 0x57); Emit8(code, 0xC0); // xorps xmm0, xmm0
+	if (prefix == 0xF2)
+		Emit8(code, 0x66);
+	Emit8(code, 0x0F); Emit8(code, 0x2E); Emit8(code, 0xC8); // ucomiss/ucomisd xmm1, xmm0
+	EmitSkip(code, 0x7A, 2 + EXIT_SIZE); // jp
+	EmitSkip(code, 0x75, EXIT_SIZE); // jne
+	EmitExit(code, bc);
+	EmitSSEVarOp(code, prefix, 0x10, XMM0, asBC_SWORDARG1(bc)); // movss/movsd xmm0, var1
+	EmitSSERegOp(code, prefix, 0x5E); // divss/divsd xmm0, xmm1
+	EmitSSEVarOp(code, prefix, 0x11, XMM0, asBC_SWORDARG0(bc)); // movss/movsd var0, xmm0
+}
+
+/// var0 = var1 op constant, for floats
+static void EmitFloatConstantMath(CODE& code, const asDWORD* bc, const unsigned int opcode)
+{
+	EmitSSEVarOp(code, 0xF3, 0x10, XMM0, asBC_SWORDARG1(bc)); // movss xmm0, var1
+	Emit8(code, 0xB8); Emit32(code, asBC_DWORDARG(bc + 1)); // mov eax, constant
+	Emit8(code, 0x66); Emit8(code, 0x0F); Emit8(code, 0x6E); Emit8(code, 0xC8); // movd xmm1, eax
+	EmitSSERegOp(code, 0xF3, opcode); // op xmm0, xmm1
+	EmitSSEVarOp(code, 0xF3, 0x11, XMM0, asBC_SWORDARG0(bc)); // movss var0, xmm0
+}
+
+static bool IsJump(const asEBCInstr op)
+{
+	switch (op)
+	{
+	case asBC_JMP:
+	case asBC_JZ:
+	case asBC_JNZ:
+	case asBC_JS:
+	case asBC_JNS:
+	case asBC_JP:
+	case asBC_JNP:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool IsSupported(const asEBCInstr op)
+{
+	if (IsJump(op))
+		return true;
+
+	switch (op)
+	{
+	case asBC_JitEntry:
+	case asBC_SUSPEND:
+	case asBC_TZ:
+	case asBC_TNZ:
+	case asBC_TS:
+	case asBC_TNS:
+	case asBC_TP:
+	case asBC_TNP:
+	case asBC_NEGi:
+	case asBC_NEGf:
+	case asBC_IncVi:
+	case asBC_DecVi:
+	case asBC_BNOT:
+	case asBC_BAND:
+	case asBC_BOR:
+	case asBC_BXOR:
+	case asBC_BSLL:
+	case asBC_BSRL:
+	case asBC_BSRA:
+	case asBC_CMPi:
+	case asBC_CMPu:
+	case asBC_CMPf:
+	case asBC_CMPd:
+	case asBC_CMPIi:
+	case asBC_CMPIu:
+	case asBC_CMPIf:
+	case asBC_SetV4:
+	case asBC_SetV8:
+	case asBC_CpyVtoV4:
+	case asBC_CpyVtoV8:
+	case asBC_CpyVtoR4:
+	case asBC_CpyVtoR8:
+	case asBC_CpyRtoV4:
+	case asBC_CpyRtoV8:
+	case asBC_iTOf:
+	case asBC_fTOi:
+	case asBC_ADDi:
+	case asBC_SUBi:
+	case asBC_MULi:
+	case asBC_ADDf:
+	case asBC_SUBf:
+	case asBC_MULf:
+	case asBC_DIVf:
+	case asBC_ADDd:
+	case asBC_SUBd:
+	case asBC_MULd:
+	case asBC_DIVd:
+	case asBC_ADDIi:
+	case asBC_SUBIi:
+	case asBC_MULIi:
+	case asBC_ADDIf:
+	case asBC_SUBIf:
+	case asBC_MULIf:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static asUINT GetJumpTarget(const asDWORD* bc, const asUINT pos)
+{
+	return static_cast<asUINT>(static_cast<int>(pos) + 2 + asBC_INTARG(bc));
+}
+
+/// Translates one supported instruction
+static void EmitInstruction(CODE& code, asDWORD* bc, const asUINT pos, std::vector<JUMP_FIXUP>& fixups)
+{
+	switch (*(asBYTE*)bc)
+	{
+	case asBC_JitEntry:
+		break;
+
+	case asBC_SUSPEND:
+		// stay in native code unless there is a line callback to call or a suspension to process
+		Emit8(code, 0x80); EmitMem(code, 7, EDI, DO_PROCESS_SUSPEND); Emit8(code, 0); // cmp byte [rdi + doProcessSuspend], 0
+		EmitSkip(code, 0x74, EXIT_SIZE); // je
+		EmitExit(code, bc);
+		break;
+
+	case asBC_JMP: EmitJump(code, 0, GetJumpTarget(bc, pos), fixups); break;
+	case asBC_JZ:  EmitConditionalJump(code, 0x84, GetJumpTarget(bc, pos), fixups); break; // je
+	case asBC_JNZ: EmitConditionalJump(code, 0x85, GetJumpTarget(bc, pos), fixups); break; // jne
+	case asBC_JS:  EmitConditionalJump(code, 0x88, GetJumpTarget(bc, pos), fixups); break; // js
+	case asBC_JNS: EmitConditionalJump(code, 0x89, GetJumpTarget(bc, pos), fixups); break; // jns
+	case asBC_JP:  EmitConditionalJump(code, 0x8F, GetJumpTarget(bc, pos), fixups); break; // jg
+	case asBC_JNP: EmitConditionalJump(code, 0x8E, GetJumpTarget(bc, pos), fixups); break; // jle
+
+	case asBC_TZ:  EmitTest(code, 0x94); break; // sete
+	case asBC_TNZ: EmitTest(code, 0x95); break; // setne
+	case asBC_TS:  EmitTest(code, 0x98); break; // sets
+	case asBC_TNS: EmitTest(code, 0x99); break; // setns
+	case asBC_TP:  EmitTest(code, 0x9F); break; // setg
+	case asBC_TNP: EmitTest(code, 0x9E); break; // setle
+
+	case asBC_NEGi:
+		EmitVarOp(code, 0xF7, 3, asBC_SWORDARG0(bc)); // neg dword var0
+		break;
+	case asBC_NEGf:
+		EmitVarOp(code, 0x81, 6, asBC_SWORDARG0(bc)); Emit32(code, 0x80000000); // xor dword var0, sign bit
+		break;
+	case asBC_IncVi:
+		EmitVarOp(code, 0xFF, 0, asBC_SWORDARG0(bc)); // inc dword var0
+		break;
+	case asBC_DecVi:
+		EmitVarOp(code, 0xFF, 1, asBC_SWORDARG0(bc)); // dec dword var0
+		break;
+	case asBC_BNOT:
+		EmitVarOp(code, 0xF7, 2, asBC_SWORDARG0(bc)); // not dword var0
+		break;
+
+	case asBC_BAND: EmitIntMath(code, bc, 0x23); break; // and
+	case asBC_BOR:  EmitIntMath(code, bc, 0x0B); break; // or
+	case asBC_BXOR: EmitIntMath(code, bc, 0x33); break; // xor
+	case asBC_ADDi: EmitIntMath(code, bc, 0x03); break; // add
+	case asBC_SUBi: EmitIntMath(code, bc, 0x2B); break; // sub
+	case asBC_MULi: EmitIntMath(code, bc, 0x0FAF); break; // imul
+
+	case asBC_BSLL:
+	case asBC_BSRL:
+	case asBC_BSRA:
+		EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG1(bc)); // mov eax, var1
+		EmitVarOp(code, 0x8B, ECX, asBC_SWORDARG2(bc)); // mov ecx, var2
+		Emit8(code, 0xD3);
+		Emit8(code, (*(asBYTE*)bc == asBC_BSLL) ? 0xE0 : ((*(asBYTE*)bc == asBC_BSRL) ? 0xE8 : 0xF8)); // shl/shr/sar eax, cl
+		EmitVarOp(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, eax
+		break;
+
+	case asBC_CMPi:
+		// the VM compares the sign of the wrapped difference, so do the same
+		EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG0(bc)); // mov eax, var0
+		EmitVarOp(code, 0x2B, EAX, asBC_SWORDARG1(bc)); // sub eax, var1
+		EmitIntSign(code);
+		break;
+	case asBC_CMPIi:
+		EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG0(bc)); // mov eax, var0
+		Emit8(code, 0x2D); Emit32(code, asBC_DWORDARG(bc)); // sub eax, constant
+		EmitIntSign(code);
+		break;
+	case asBC_CMPu:
+		EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG0(bc)); // mov eax, var0
+		EmitVarOp(code, 0x3B, EAX, asBC_SWORDARG1(bc)); // cmp eax, var1
+		EmitUnsignedCompareResult(code);
+		break;
+	case asBC_CMPIu:
+		EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG0(bc)); // mov eax, var0
+		Emit8(code, 0x3D); Emit32(code, asBC_DWORDARG(bc)); // cmp eax, constant
+		EmitUnsignedCompareResult(code);
+		break;
+	case asBC_CMPf:
+		EmitSSEVarOp(code, 0xF3, 0x10, XMM0, asBC_SWORDARG0(bc)); // movss xmm0, var0
+		EmitSSEVarOp(code, 0xF3, 0x5C, XMM0, asBC_SWORDARG1(bc)); // subss xmm0, var1
+		EmitFloatSign(code, false);
+		break;
+	case asBC_CMPd:
+		EmitSSEVarOp(code, 0xF2, 0x10, XMM0, asBC_SWORDARG0(bc)); // movsd xmm0, var0
+		EmitSSEVarOp(code, 0xF2, 0x5C, XMM0, asBC_SWORDARG1(bc)); // subsd xmm0, var1
+		EmitFloatSign(code, true);
+		break;
+	case asBC_CMPIf:
+		EmitSSEVarOp(code, 0xF3, 0x10, XMM0, asBC_SWORDARG0(bc)); // movss xmm0, var0
+		Emit8(code, 0xB8); Emit32(code, asBC_DWORDARG(bc)); // mov eax, constant
+		Emit8(code, 0x66); Emit8(code, 0x0F); Emit8(code, 0x6E); Emit8(code, 0xC8); // movd xmm1, eax
+		EmitSSERegOp(code, 0xF3, 0x5C); // subss xmm0, xmm1
+		EmitFloatSign(code, false);
+		break;
+
+	case asBC_SetV4:
+		EmitVarOp(code, 0xC7, 0, asBC_SWORDARG0(bc)); Emit32(code, asBC_DWORDARG(bc)); // mov dword var0, constant
+		break;
+	case asBC_SetV8:
+		Emit8(code, 0x48); Emit8(code, 0xB8); Emit64(code, asBC_QWORDARG(bc)); // mov rax, constant
+		EmitVarOp64(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, rax
+		break;
+	case asBC_CpyVtoV4:
+		EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG1(bc)); // mov eax, var1
+		EmitVarOp(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, eax
+		break;
+	case asBC_CpyVtoV8:
+		EmitVarOp64(code, 0x8B, EAX, asBC_SWORDARG1(bc)); // mov rax, var1
+		EmitVarOp64(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, rax
+		break;
+	case asBC_CpyVtoR4:
+		EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG0(bc)); // mov eax, var0
+		Emit8(code, 0x89); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov [rdi + valueRegister], eax
+		break;
+	case asBC_CpyVtoR8:
+		EmitVarOp64(code, 0x8B, EAX, asBC_SWORDARG0(bc)); // mov rax, var0
+		Emit8(code, 0x48); Emit8(code, 0x89); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov [rdi + valueRegister], rax
+		break;
+	case asBC_CpyRtoV4:
+		Emit8(code, 0x8B); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov eax, [rdi + valueRegister]
+		EmitVarOp(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, eax
+		break;
+	case asBC_CpyRtoV8:
+		Emit8(code, 0x48); Emit8(code, 0x8B); EmitMem(code, EAX, EDI, VALUE_REGISTER); // mov rax, [rdi + valueRegister]
+		EmitVarOp64(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, rax
+		break;
+
+	case asBC_iTOf:
+		EmitSSEVarOp(code, 0xF3, 0x2A, XMM0, asBC_SWORDARG0(bc)); // cvtsi2ss xmm0, var0
+		EmitSSEVarOp(code, 0xF3, 0x11, XMM0, asBC_SWORDARG0(bc)); // movss var0, xmm0
+		break;
+	case asBC_fTOi:
+		EmitSSEVarOp(code, 0xF3, 0x2C, EAX, asBC_SWORDARG0(bc)); // cvttss2si eax, var0
+		EmitVarOp(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, eax
+		break;
+
+	case asBC_ADDf: EmitFloatMath(code, bc, 0xF3, 0x58); break; // addss
+	case asBC_SUBf: EmitFloatMath(code, bc, 0xF3, 0x5C); break; // subss
+	case asBC_MULf: EmitFloatMath(code, bc, 0xF3, 0x59); break; // mulss
+	case asBC_DIVf: EmitFloatDivision(code, bc, 0xF3); break;
+	case asBC_ADDd: EmitFloatMath(code, bc, 0xF2, 0x58); break; // addsd
+	case asBC_SUBd: EmitFloatMath(code, bc, 0xF2, 0x5C); break; // subsd
+	case asBC_MULd: EmitFloatMath(code, bc, 0xF2, 0x59); break; // mulsd
+	case asBC_DIVd: EmitFloatDivision(code, bc, 0xF2); break;
+
+	case asBC_ADDIi:
+	case asBC_SUBIi:
+	case asBC_MULIi:
+		EmitVarOp(code, 0x8B, EAX, asBC_SWORDARG1(bc)); // mov eax, var1
+		if (*(asBYTE*)bc == asBC_MULIi)
+		{
+			Emit8(code, 0x69); Emit8(code, 0xC0); // imul eax, eax, constant
+		}
+		else
+		{
+			Emit8(code, (*(asBYTE*)bc == asBC_ADDIi) ? 0x05 : 0x2D); // add/sub eax, constant
+		}
+		Emit32(code, asBC_DWORDARG(bc + 1));
+		EmitVarOp(code, 0x89, EAX, asBC_SWORDARG0(bc)); // mov var0, eax
+		break;
+
+	case asBC_ADDIf: EmitFloatConstantMath(code, bc, 0x58); break; // addss
+	case asBC_SUBIf: EmitFloatConstantMath(code, bc, 0x5C); break; // subss
+	case asBC_MULIf: EmitFloatConstantMath(code, bc, 0x59); break; // mulss
+	}
+}
+
+int ETHJITCompiler::CompileFunction(asIScriptFunction *function, asJITFunction *output)
+{
+	asUINT length = 0;
+	asDWORD *byteCode = function->GetByteCode(&length);
+	if (!byteCode || length == 0)
+		return asERROR;
+
+	// map out instruction boundaries and make sure every jump lands on one of them
+	std::vector<bool> isInstruction(length, false);
+	std::vector<asUINT> jumpTargets;
+	asUINT pos = 0;
+	while (pos < length)
+	{
+		const asEBCInstr op = static_cast<asEBCInstr>(*(asBYTE*)&byteCode[pos]);
+		const int size = asBCTypeSize[asBCInfo[op].type];
+		if (size <= 0)
+			return asERROR;
+		isInstruction[pos] = true;
+		if (IsJump(op))
+			jumpTargets.push_back(GetJumpTarget(&byteCode[pos], pos));
+		pos += size;
+	}
+	if (pos != length)
+		return asERROR;
+	for (std::size_t t = 0; t < jumpTargets.size(); t++)
+	{
+		if (jumpTargets[t] >= length || !isInstruction[jumpTargets[t]])
+			return asERROR;
+	}
+
+	CODE code;
+	Emit8(code, 0x89); Emit8(code, 0xF0); // mov eax, esi
+	Emit8(code, 0x48); Emit8(code, 0x8B); EmitMem(code, ESI, EDI, STACK_FRAME_POINTER); // mov rsi, [rdi + stackFramePointer]
+	Emit8(code, 0x48); Emit8(code, 0x8D); Emit8(code, 0x15); // lea rdx, [rip + entry table]
+	const std::size_t tableFixup = code.size();
+	Emit32(code, 0);
+	Emit8(code, 0xFF); Emit8(code, 0x24); Emit8(code, 0xC2); // jmp [rdx + rax * 8]
+
+	// unsupported instructions become exits to the VM, so every instruction gets a native address
+	std::vector<std::size_t> labels(length, 0);
+	std::vector<JUMP_FIXUP> fixups;
+	std::vector<asUINT> entries;
+	asUINT lastPos = 0;
+	for (pos = 0; pos < length; pos += asBCTypeSize[asBCInfo[*(asBYTE*)&byteCode[pos]].type])
+	{
+		asDWORD *bc = &byteCode[pos];
+		const asEBCInstr op = static_cast<asEBCInstr>(*(asBYTE*)bc);
+		labels[pos] = code.size();
+		lastPos = pos;
+
+		if (!IsSupported(op))
+		{
+			EmitExit(code, bc);
+			continue;
+		}
+
+		// entering right before an exit would only bounce back to the VM
+		if (op == asBC_JitEntry && entries.size() < MAX_ENTRIES)
+		{
+			const asUINT next = pos + asBCTypeSize[asBCInfo[op].type];
+			if (next < length && IsSupported(static_cast<asEBCInstr>(*(asBYTE*)&byteCode[next])))
+				entries.push_back(pos);
+		}
+		EmitInstruction(code, bc, pos, fixups);
+	}
+
+	// native code must never run past the last instruction
+	const asEBCInstr lastOp = static_cast<asEBCInstr>(*(asBYTE*)&byteCode[lastPos]);
+	if (entries.empty() || (IsSupported(lastOp) && lastOp != asBC_JMP))
+		return asERROR;
+
+	for (std::size_t t = 0; t < fixups.size(); t++)
+	{
+		const std::size_t from = fixups[t].codePos + 4;
+		Patch32(code, fixups[t].codePos, static_cast<asDWORD>(static_cast<int>(labels[fixups[t].target]) - static_cast<int>(from)));
+	}
+
+	// the entry table holds absolute addresses, so it is filled once the memory is allocated
+	while (code.size() % sizeof(asQWORD))
+		Emit8(code, 0xCC); // int3
+	const std::size_t tablePos = code.size();
+	Patch32(code, tableFixup, static_cast<asDWORD>(tablePos - (tableFixup + 4)));
+	const std::size_t size = tablePos + (entries.size() * sizeof(asQWORD));
+
+	void *memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (memory == MAP_FAILED)
+		return asERROR;
+
+	unsigned char *bytes = static_cast<unsigned char*>(memory);
+	std::memcpy(bytes, &code[0], code.size());
+	for (std::size_t t = 0; t < entries.size(); t++)
+	{
+		const asQWORD address = reinterpret_cast<asQWORD>(bytes + labels[entries[t]]);
+		std::memcpy(bytes + tablePos + (t * sizeof(asQWORD)), &address, sizeof(asQWORD));
+	}
+
+	if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0)
+	{
+		munmap(memory, size);
+		return asERROR;
+	}
+
+	// the VM passes the JitEntry argument minus one as the entry id
+	for (pos = 0; pos < length; pos += asBCTypeSize[asBCInfo[*(asBYTE*)&byteCode[pos]].type])
+	{
+		if (*(asBYTE*)&byteCode[pos] == asBC_JitEntry)
+			asBC_WORDARG0(&byteCode[pos]) = 0;
+	}
+	for (std::size_t t = 0; t < entries.size(); t++)
+	{
+		asBC_WORDARG0(&byteCode[entries[t]]) = static_cast<asWORD>(t + 1);
+	}
+
+	*output = reinterpret_cast<asJITFunction>(memory);
+	m_functions[*output] = size;
+	return asSUCCESS;
+}
+
+void ETHJITCompiler::ReleaseJITFunction(asJITFunction func)
+{
+	std::map<asJITFunction, std::size_t>::iterator iter = m_functions.find(func);
+	if (iter == m_functions.end())
+		return;
+	munmap(reinterpret_cast<void*>(iter->first), iter->second);
+	m_functions.erase(iter);
+}
+
+#else
+
+int ETHJITCompiler::CompileFunction(asIScriptFunction *, asJITFunction *)
+{
+	return asNOT_SUPPORTED;
+}
+
+void ETHJITCompiler::ReleaseJITFunction(asJITFunction)
+{
+}
+
+#endif
@@ -0,0 +1,53 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_JIT_COMPILER_H_
+#define ETH_JIT_COMPILER_H_
+
+#include "../../angelscript/include/angelscript.h"
+#include <map>
+#include <cstddef>
+
+#if defined(__linux__) && defined(__x86_64__) && !defined(ANDROID)
+ #define ETH_JIT_COMPILER_ENABLED
+#endif
+
+/// Translates script functions to x86-64 machine code. Only instructions that work on local
+/// variables and on the value register (arithmetic, comparisons, conversions, copies and jumps)
+/// are translated. Whenever native code reaches any other instruction it hands execution back to
+/// the VM, which re-enters the native code at the next JitEntry instruction
+class ETHJITCompiler : public asIJITCompiler
+{
+	/// Executable memory blocks and their sizes, indexed by the function they hold
+	std::map<asJITFunction, std::size_t> m_functions;
+
+public:
+	/// JitEntry instructions store entry ids in a 16-bit argument, and 0 means "no entry"
+	static const std::size_t MAX_ENTRIES;
+
+	~ETHJITCompiler();
+
+	int CompileFunction(asIScriptFunction *function, asJITFunction *output);
+	void ReleaseJITFunction(asJITFunction func);
+};
+
+#endif
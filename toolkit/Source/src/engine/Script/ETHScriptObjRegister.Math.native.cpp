@@ -0,0 +1,53 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of this
+	software and associated documentation files (the "Software"), to deal in the
+	Software without restriction, including without limitation the rights to use, copy,
+	modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so, subject to the
+	following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHScriptObjRegister.h"
+
+void RegisterCollisionMethods(asIScriptEngine *pASEngine)
+{
+	int r;
+	r = pASEngine->RegisterObjectBehaviour("collisionBox", asBEHAVE_CONSTRUCT,  "void f()",                                     asFUNCTION(CollisionBoxDefaultConstructor), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = pASEngine->RegisterObjectBehaviour("collisionBox", asBEHAVE_CONSTRUCT,  "void f(const collisionBox &in)",               asFUNCTION(CollisionBoxCopyConstructor),    asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = pASEngine->RegisterObjectBehaviour("collisionBox", asBEHAVE_CONSTRUCT,  "void f(const vector3 &in, const vector3 &in)", asFUNCTION(CollisionBoxInitConstructor),    asCALL_CDECL_OBJLAST); assert( r >= 0 );
+}
+
+void RegisterMathFunctionsAndMethods(asIScriptEngine *pASEngine)
+{
+	int r;
+	r = pASEngine->RegisterObjectBehaviour("matrix4x4", asBEHAVE_CONSTRUCT,  "void f()",                    asFUNCTION(Matrix4x4DefaultConstructor), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = pASEngine->RegisterObjectBehaviour("matrix4x4", asBEHAVE_CONSTRUCT,  "void f(const matrix4x4 &in)", asFUNCTION(Matrix4x4CopyConstructor), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+
+	// matrix functions
+	r = pASEngine->RegisterGlobalFunction("matrix4x4 scale(const float, const float, const float)", asFUNCTION(Scale), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("matrix4x4 translate(const float, const float, const float)", asFUNCTION(Translate), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("matrix4x4 rotateX(const float)", asFUNCTION(RotateX), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("matrix4x4 rotateY(const float)", asFUNCTION(RotateY), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("matrix4x4 rotateZ(const float)", asFUNCTION(RotateZ), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("matrix4x4 multiply(const matrix4x4 &in, const matrix4x4 &in)", asFUNCTIONPR(Multiply, (const Matrix4x4&, const Matrix4x4&), Matrix4x4), asCALL_CDECL); assert(r >= 0);
+
+	// methods from globals
+	r = pASEngine->RegisterObjectMethod("matrix4x4", "float get(const uint i, const uint j) const", asFUNCTION(Matrix4x4Getter), asCALL_CDECL_OBJLAST); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("matrix4x4", "void set(const uint i, const uint j, const float)", asFUNCTION(Matrix4x4Setter), asCALL_CDECL_OBJLAST); assert(r >= 0);
+
+	// misc functions:
+	r = pASEngine->RegisterGlobalFunction("float getAngle(const vector2 &in)", asFUNCTION(GetAngle), asCALL_CDECL); assert(r >= 0);
+}
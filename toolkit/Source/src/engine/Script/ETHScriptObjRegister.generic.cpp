@@ -183,6 +183,12 @@ asDECLARE_METHOD_WRAPPERPR(__size,               ETHEntityArray, size,
 asDECLARE_METHOD_WRAPPERPR(__clear,              ETHEntityArray, clear,              (void),            void);
 asDECLARE_METHOD_WRAPPERPR(__unique,             ETHEntityArray, unique,             (void),            void);
 asDECLARE_METHOD_WRAPPERPR(__removeDeadEntities, ETHEntityArray, removeDeadEntities, (void),            void);
+asDECLARE_METHOD_WRAPPERPR(__setColorArray,      ETHEntityArray, setColor,           (const Vector3&),          void);
+asDECLARE_METHOD_WRAPPERPR(__setAlphaArray,      ETHEntityArray, setAlpha,           (const float),             void);
+asDECLARE_METHOD_WRAPPERPR(__hideArray,          ETHEntityArray, hide,               (const bool),              void);
+asDECLARE_METHOD_WRAPPERPR(__filterByName,       ETHEntityArray, filterByName,       (const str_type::string&), void);
+asDECLARE_METHOD_WRAPPERPR(__filterByCustomData, ETHEntityArray, filterByCustomData, (const str_type::string&), void);
+asDECLARE_METHOD_WRAPPERPR(__sortByDistance,     ETHEntityArray, sortByDistance,     (const Vector2&),          void);
 
 void RegisterEntityArrayMethods(asIScriptEngine *pASEngine)
 {
@@ -201,6 +207,14 @@ void RegisterEntityArrayMethods(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void clear()",                        asFUNCTION(__clear),              asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void unique()",                       asFUNCTION(__unique),             asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void removeDeadEntities()",           asFUNCTION(__removeDeadEntities), asCALL_GENERIC); assert(r >= 0);
+
+	// bulk operations
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void setColor(const vector3 &in)",           asFUNCTION(__setColorArray),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void setAlpha(const float)",                 asFUNCTION(__setAlphaArray),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void hide(const bool)",                      asFUNCTION(__hideArray),          asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void filterByName(const string &in)",        asFUNCTION(__filterByName),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void filterByCustomData(const string &in)",  asFUNCTION(__filterByCustomData), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void sortByDistance(const vector2 &in)",     asFUNCTION(__sortByDistance),     asCALL_GENERIC); assert(r >= 0);
 }
 
 asDECLARE_METHOD_WRAPPERPR(__AddRefEntity,  ETHScriptEntity, AddRef,  (void), void);
@@ -273,12 +287,12 @@ asDECLARE_METHOD_WRAPPERPR(__ScaleParticleSystem,   ETHScriptEntity, ScalePartic
 asDECLARE_METHOD_WRAPPERPR(__MirrorParticleSystemX, ETHScriptEntity, MirrorParticleSystemX, (const unsigned int n, const bool),               bool);
 asDECLARE_METHOD_WRAPPERPR(__MirrorParticleSystemY, ETHScriptEntity, MirrorParticleSystemY, (const unsigned int n, const bool),               bool);
 
-asDECLARE_METHOD_WRAPPERPR(__SetFloat,   ETHScriptEntity, SetFloat,   (const str_type::string&, const float&),            bool);
-asDECLARE_METHOD_WRAPPERPR(__SetInt,     ETHScriptEntity, SetInt,     (const str_type::string&, const int&),              bool);
-asDECLARE_METHOD_WRAPPERPR(__SetUInt,    ETHScriptEntity, SetUInt,    (const str_type::string&, const unsigned int&),     bool);
-asDECLARE_METHOD_WRAPPERPR(__SetString,  ETHScriptEntity, SetString,  (const str_type::string&, const str_type::string&), bool);
-asDECLARE_METHOD_WRAPPERPR(__SetVector2, ETHScriptEntity, SetVector2, (const str_type::string&, const Vector2&),          bool);
-asDECLARE_METHOD_WRAPPERPR(__SetVector3, ETHScriptEntity, SetVector3, (const str_type::string&, const Vector3&),          bool);
+asDECLARE_METHOD_WRAPPERPR(__SetFloat,   ETHScriptEntity, SetFloat,   (const str_type::string&, const float&),            void);
+asDECLARE_METHOD_WRAPPERPR(__SetInt,     ETHScriptEntity, SetInt,     (const str_type::string&, const int&),              void);
+asDECLARE_METHOD_WRAPPERPR(__SetUInt,    ETHScriptEntity, SetUInt,    (const str_type::string&, const unsigned int&),     void);
+asDECLARE_METHOD_WRAPPERPR(__SetString,  ETHScriptEntity, SetString,  (const str_type::string&, const str_type::string&), void);
+asDECLARE_METHOD_WRAPPERPR(__SetVector2, ETHScriptEntity, SetVector2, (const str_type::string&, const Vector2&),          void);
+asDECLARE_METHOD_WRAPPERPR(__SetVector3, ETHScriptEntity, SetVector3, (const str_type::string&, const Vector3&),          void);
 asDECLARE_METHOD_WRAPPERPR(__GetFloat,   ETHScriptEntity, GetFloat,   (const str_type::string&) const,                    float);
 asDECLARE_METHOD_WRAPPERPR(__GetInt,     ETHScriptEntity, GetInt,     (const str_type::string&) const,                    int);
 asDECLARE_METHOD_WRAPPERPR(__GetUInt,    ETHScriptEntity, GetUInt,    (const str_type::string&) const,                    unsigned int);
@@ -315,6 +329,32 @@ asDECLARE_METHOD_WRAPPERPR(__MultiplyUInt,    ETHScriptEntity, MultiplyUInt,
 asDECLARE_METHOD_WRAPPERPR(__MultiplyVector2, ETHScriptEntity, MultiplyVector2, (const str_type::string&, const float&),        void);
 asDECLARE_METHOD_WRAPPERPR(__MultiplyVector3, ETHScriptEntity, MultiplyVector3, (const str_type::string&, const float&),        void);
 
+asDECLARE_METHOD_WRAPPERPR(__SetFloatByKey, ETHScriptEntity, SetFloat, (const unsigned int, const float), void);
+asDECLARE_METHOD_WRAPPERPR(__SetIntByKey, ETHScriptEntity, SetInt, (const unsigned int, const int), void);
+asDECLARE_METHOD_WRAPPERPR(__SetUIntByKey, ETHScriptEntity, SetUInt, (const unsigned int, const unsigned int), void);
+asDECLARE_METHOD_WRAPPERPR(__SetStringByKey, ETHScriptEntity, SetString, (const unsigned int, const str_type::string&), void);
+asDECLARE_METHOD_WRAPPERPR(__SetVector2ByKey, ETHScriptEntity, SetVector2, (const unsigned int, const Vector2&), void);
+asDECLARE_METHOD_WRAPPERPR(__SetVector3ByKey, ETHScriptEntity, SetVector3, (const unsigned int, const Vector3&), void);
+asDECLARE_METHOD_WRAPPERPR(__GetFloatByKey, ETHScriptEntity, GetFloat, (const unsigned int) const, float);
+asDECLARE_METHOD_WRAPPERPR(__GetIntByKey, ETHScriptEntity, GetInt, (const unsigned int) const, int);
+asDECLARE_METHOD_WRAPPERPR(__GetUIntByKey, ETHScriptEntity, GetUInt, (const unsigned int) const, unsigned int);
+asDECLARE_METHOD_WRAPPERPR(__GetStringByKey, ETHScriptEntity, GetString, (const unsigned int) const, str_type::string);
+asDECLARE_METHOD_WRAPPERPR(__GetVector2ByKey, ETHScriptEntity, GetVector2, (const unsigned int) const, Vector2);
+asDECLARE_METHOD_WRAPPERPR(__GetVector3ByKey, ETHScriptEntity, GetVector3, (const unsigned int) const, Vector3);
+asDECLARE_METHOD_WRAPPERPR(__AddToFloatByKey, ETHScriptEntity, AddToFloat, (const unsigned int, const float), void);
+asDECLARE_METHOD_WRAPPERPR(__AddToIntByKey, ETHScriptEntity, AddToInt, (const unsigned int, const int), void);
+asDECLARE_METHOD_WRAPPERPR(__AddToUIntByKey, ETHScriptEntity, AddToUInt, (const unsigned int, const unsigned int), void);
+asDECLARE_METHOD_WRAPPERPR(__AddToVector2ByKey, ETHScriptEntity, AddToVector2, (const unsigned int, const Vector2&), void);
+asDECLARE_METHOD_WRAPPERPR(__AddToVector3ByKey, ETHScriptEntity, AddToVector3, (const unsigned int, const Vector3&), void);
+asDECLARE_METHOD_WRAPPERPR(__MultiplyFloatByKey, ETHScriptEntity, MultiplyFloat, (const unsigned int, const float), void);
+asDECLARE_METHOD_WRAPPERPR(__MultiplyIntByKey, ETHScriptEntity, MultiplyInt, (const unsigned int, const int), void);
+asDECLARE_METHOD_WRAPPERPR(__MultiplyUIntByKey, ETHScriptEntity, MultiplyUInt, (const unsigned int, const unsigned int), void);
+asDECLARE_METHOD_WRAPPERPR(__MultiplyVector2ByKey, ETHScriptEntity, MultiplyVector2, (const unsigned int, const float), void);
+asDECLARE_METHOD_WRAPPERPR(__MultiplyVector3ByKey, ETHScriptEntity, MultiplyVector3, (const unsigned int, const float), void);
+asDECLARE_METHOD_WRAPPERPR(__EraseDataByKey, ETHScriptEntity, EraseData, (const unsigned int), bool);
+asDECLARE_METHOD_WRAPPERPR(__CheckCustomDataByKey, ETHScriptEntity, CheckCustomData, (const unsigned int) const, ETH_CUSTOM_DATA_TYPE);
+asDECLARE_FUNCTION_WRAPPER(__GetCustomDataKey, ETHCustomDataManager::GetKey);
+
 asDECLARE_METHOD_WRAPPERPR(__SetScale, ETHScriptEntity, SetScale, (const Vector2&), void);
 asDECLARE_METHOD_WRAPPERPR(__ScaleV2,  ETHScriptEntity, Scale,    (const Vector2&), void);
 asDECLARE_METHOD_WRAPPERPR(__ScaleF,   ETHScriptEntity, Scale,    (const float),    void);
@@ -428,9 +468,42 @@ void RegisterEntityMethods(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void MultiplyVector2(const string &in, const float &in)", asFUNCTION(__MultiplyVector2), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void MultiplyVector3(const string &in, const float &in)", asFUNCTION(__MultiplyVector3), asCALL_GENERIC); assert(r >= 0);
 
+	// custom data keys let hot loops skip the name lookup
+	r = pASEngine->RegisterGlobalFunction("uint GetCustomDataKey(const string &in)", asFUNCTION(__GetCustomDataKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetFloat(const uint, const float)", asFUNCTION(__SetFloatByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetInt(const uint, const int)", asFUNCTION(__SetIntByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetUInt(const uint, const uint)", asFUNCTION(__SetUIntByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetString(const uint, const string &in)", asFUNCTION(__SetStringByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetVector2(const uint, const vector2 &in)", asFUNCTION(__SetVector2ByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetVector3(const uint, const vector3 &in)", asFUNCTION(__SetVector3ByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "float GetFloat(const uint) const", asFUNCTION(__GetFloatByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "int GetInt(const uint) const", asFUNCTION(__GetIntByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "uint GetUInt(const uint) const", asFUNCTION(__GetUIntByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "string GetString(const uint) const", asFUNCTION(__GetStringByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "vector2 GetVector2(const uint) const", asFUNCTION(__GetVector2ByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "vector3 GetVector3(const uint) const", asFUNCTION(__GetVector3ByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToFloat(const uint, const float)", asFUNCTION(__AddToFloatByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToInt(const uint, const int)", asFUNCTION(__AddToIntByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToUInt(const uint, const uint)", asFUNCTION(__AddToUIntByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToVector2(const uint, const vector2 &in)", asFUNCTION(__AddToVector2ByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToVector3(const uint, const vector3 &in)", asFUNCTION(__AddToVector3ByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void MultiplyFloat(const uint, const float)", asFUNCTION(__MultiplyFloatByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void MultiplyInt(const uint, const int)", asFUNCTION(__MultiplyIntByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void MultiplyUInt(const uint, const uint)", asFUNCTION(__MultiplyUIntByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void MultiplyVector2(const uint, const float)", asFUNCTION(__MultiplyVector2ByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void MultiplyVector3(const uint, const float)", asFUNCTION(__MultiplyVector3ByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "bool EraseData(const uint)", asFUNCTION(__EraseDataByKey), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "DATA_TYPE CheckCustomData(const uint) const", asFUNCTION(__CheckCustomDataByKey), asCALL_GENERIC); assert(r >= 0);
+
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "ETHPhysicsController@ GetPhysicsController()", asFUNCTION(__GetPhysicsController), asCALL_GENERIC); assert(r >= 0);
 }
 
+#ifdef ETH_NATIVE_MATH_CALLS
+
+#include "ETHScriptObjRegister.Math.native.cpp"
+
+#else
+
 asDECLARE_FUNCTION_OBJ_WRAPPER(__CollisionBoxDefaultConstructor, CollisionBoxDefaultConstructor, false);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__CollisionBoxCopyConstructor,    CollisionBoxCopyConstructor,    false);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__CollisionBoxInitConstructor,    CollisionBoxInitConstructor,    false);
@@ -488,6 +561,8 @@ void RegisterMathFunctionsAndMethods(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("float getAngle(const vector2 &in)", asFUNCTION(__GetAngle), asCALL_GENERIC); assert(r >= 0);
 }
 
+#endif
+
 asDECLARE_FUNCTION_WRAPPER(__DateTimeFactory, DateTimeFactory);
 
 asDECLARE_METHOD_WRAPPERPR(__addRefDateTime,  ETHDateTime, AddRef,  (void), void);
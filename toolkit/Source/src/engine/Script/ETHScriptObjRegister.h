@@ -29,6 +29,13 @@
 #include <string>
 #include <enml/enml.h>
 
+// the x86-64 Linux build registers math types and functions with the native calling convention,
+// unless AngelScript was built without native calling convention support. The .generic.cpp
+// units then include the registrations from their .native.cpp counterparts
+#if defined(__linux__) && defined(__x86_64__) && !defined(ANDROID) && !defined(AS_MAX_PORTABILITY)
+ #define ETH_NATIVE_MATH_CALLS
+#endif
+
 namespace ETHGlobal
 {
 	void DateTimeConstructor(ETHDateTime *self);
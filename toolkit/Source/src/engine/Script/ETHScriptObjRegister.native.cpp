@@ -118,6 +118,14 @@ void RegisterEntityArrayMethods(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void clear()", asMETHOD(ETHEntityArray,clear), asCALL_THISCALL); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void unique()", asMETHOD(ETHEntityArray,unique), asCALL_THISCALL); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void removeDeadEntities()", asMETHOD(ETHEntityArray,removeDeadEntities), asCALL_THISCALL); assert(r >= 0);
+
+	// bulk operations
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void setColor(const vector3 &in)", asMETHOD(ETHEntityArray,setColor), asCALL_THISCALL); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void setAlpha(const float)", asMETHOD(ETHEntityArray,setAlpha), asCALL_THISCALL); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void hide(const bool)", asMETHOD(ETHEntityArray,hide), asCALL_THISCALL); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void filterByName(const string &in)", asMETHOD(ETHEntityArray,filterByName), asCALL_THISCALL); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void filterByCustomData(const string &in)", asMETHOD(ETHEntityArray,filterByCustomData), asCALL_THISCALL); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void sortByDistance(const vector2 &in)", asMETHOD(ETHEntityArray,sortByDistance), asCALL_THISCALL); assert(r >= 0);
 }
 
 void RegisterEntityMethods(asIScriptEngine *pASEngine)
@@ -222,35 +230,7 @@ void RegisterEntityMethods(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void MultiplyVector3(const string &in, const float &in)", asMETHOD(ETHScriptEntity,MultiplyVector3), asCALL_THISCALL); assert(r >= 0);
 }
 
-void RegisterCollisionMethods(asIScriptEngine *pASEngine)
-{
-	int r;
-	r = pASEngine->RegisterObjectBehaviour("collisionBox", asBEHAVE_CONSTRUCT,  "void f()",                                     asFUNCTION(CollisionBoxDefaultConstructor), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = pASEngine->RegisterObjectBehaviour("collisionBox", asBEHAVE_CONSTRUCT,  "void f(const collisionBox &in)",               asFUNCTION(CollisionBoxCopyConstructor),    asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = pASEngine->RegisterObjectBehaviour("collisionBox", asBEHAVE_CONSTRUCT,  "void f(const vector3 &in, const vector3 &in)", asFUNCTION(CollisionBoxInitConstructor),    asCALL_CDECL_OBJLAST); assert( r >= 0 );
-}
-
-void RegisterMathFunctionsAndMethods(asIScriptEngine *pASEngine)
-{
-	int r;
-	r = pASEngine->RegisterObjectBehaviour("matrix4x4", asBEHAVE_CONSTRUCT,  "void f()",                    asFUNCTION(Matrix4x4DefaultConstructor), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = pASEngine->RegisterObjectBehaviour("matrix4x4", asBEHAVE_CONSTRUCT,  "void f(const matrix4x4 &in)", asFUNCTION(Matrix4x4CopyConstructor), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-
-	// matrix functions
-	r = pASEngine->RegisterGlobalFunction("matrix4x4 scale(const float, const float, const float)", asFUNCTION(Scale), asCALL_CDECL); assert(r >= 0);
-	r = pASEngine->RegisterGlobalFunction("matrix4x4 translate(const float, const float, const float)", asFUNCTION(Translate), asCALL_CDECL); assert(r >= 0);
-	r = pASEngine->RegisterGlobalFunction("matrix4x4 rotateX(const float)", asFUNCTION(RotateX), asCALL_CDECL); assert(r >= 0);
-	r = pASEngine->RegisterGlobalFunction("matrix4x4 rotateY(const float)", asFUNCTION(RotateY), asCALL_CDECL); assert(r >= 0);
-	r = pASEngine->RegisterGlobalFunction("matrix4x4 rotateZ(const float)", asFUNCTION(RotateZ), asCALL_CDECL); assert(r >= 0);
-	r = pASEngine->RegisterGlobalFunction("matrix4x4 multiply(const matrix4x4 &in, const matrix4x4 &in)", asFUNCTIONPR(Multiply, (const Matrix4x4&, const Matrix4x4&), Matrix4x4), asCALL_CDECL); assert(r >= 0);
-
-	// methods from globals
-	r = pASEngine->RegisterObjectMethod("matrix4x4", "float get(const uint i, const uint j) const", asFUNCTION(Matrix4x4Getter), asCALL_CDECL_OBJLAST); assert(r >= 0);
-	r = pASEngine->RegisterObjectMethod("matrix4x4", "void set(const uint i, const uint j, const float)", asFUNCTION(Matrix4x4Setter), asCALL_CDECL_OBJLAST); assert(r >= 0);
-
-	// misc functions:
-	r = pASEngine->RegisterGlobalFunction("float getAngle(const vector2 &in)", asFUNCTION(GetAngle), asCALL_CDECL); assert(r >= 0);
-}
+#include "ETHScriptObjRegister.Math.native.cpp"
 
 void RegisterDateTimeMethods(asIScriptEngine *pASEngine)
 {
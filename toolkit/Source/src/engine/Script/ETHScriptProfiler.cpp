@@ -0,0 +1,191 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHScriptProfiler.h"
+#include "../Resource/ETHResourceProvider.h"
+#include <fstream>
+
+bool ETHScriptProfiler::m_enabled = false;
+str_type::string ETHScriptProfiler::m_outputFile;
+gs2d::VideoPtr ETHScriptProfiler::m_video;
+asIScriptEngine* ETHScriptProfiler::m_engine = 0;
+unsigned long ETHScriptProfiler::m_lastSampleTime = 0;
+std::vector<ETHScriptProfiler::EXECUTION> ETHScriptProfiler::m_executions;
+std::map<ETHScriptProfiler::CALL_STACK, unsigned long> ETHScriptProfiler::m_samples;
+
+void ETHScriptProfiler::Start(const gs2d::VideoPtr& video, asIScriptEngine* pASEngine, const str_type::string& outputFile)
+{
+	m_video = video;
+	m_engine = pASEngine;
+	m_outputFile = outputFile;
+	m_executions.clear();
+	m_samples.clear();
+	m_enabled = true;
+
+	ETH_STREAM_DECL(ss) << GS_L("Script profiler enabled. Output file: ") << m_outputFile;
+	ETHResourceProvider::Log(ss.str(), Platform::Logger::INFO);
+}
+
+void ETHScriptProfiler::AttachContext(asIScriptContext* pContext)
+{
+	if (m_enabled)
+		pContext->SetLineCallback(asFUNCTION(LineCallback), 0, asCALL_CDECL);
+}
+
+bool ETHScriptProfiler::IsEnabled()
+{
+	return m_enabled;
+}
+
+void ETHScriptProfiler::BeginExecution(asIScriptContext* pContext, const int functionId)
+{
+	if (!m_enabled)
+		return;
+
+	const unsigned long now = m_video->GetElapsedTime();
+
+	// time spent outside scripts is not charged to anyone
+	if (m_executions.empty())
+		m_lastSampleTime = now;
+	else
+		Sample(now, false);
+
+	EXECUTION execution;
+	execution.context = pContext;
+	execution.functionId = functionId;
+	m_executions.push_back(execution);
+}
+
+void ETHScriptProfiler::EndExecution()
+{
+	if (!m_enabled || m_executions.empty())
+		return;
+
+	// the context has already returned, so whatever is left goes to its entry function
+	Sample(m_video->GetElapsedTime(), true);
+	m_executions.pop_back();
+}
+
+void ETHScriptProfiler::LineCallback(asIScriptContext* pContext, void* param)
+{
+	GS2D_UNUSED_ARGUMENT(pContext);
+	GS2D_UNUSED_ARGUMENT(param);
+	if (m_executions.empty())
+		return;
+
+	const unsigned long now = m_video->GetElapsedTime();
+	if (now != m_lastSampleTime)
+		Sample(now, false);
+}
+
+void ETHScriptProfiler::Sample(const unsigned long now, const bool topFinished)
+{
+	if (now <= m_lastSampleTime)
+		return;
+
+	CALL_STACK stack;
+	BuildCallStack(stack, topFinished);
+	m_samples[stack] += now - m_lastSampleTime;
+	m_lastSampleTime = now;
+}
+
+void ETHScriptProfiler::BuildCallStack(CALL_STACK& stack, const bool topFinished)
+{
+	const std::size_t numExecutions = m_executions.size();
+	for (std::size_t t = 0; t < numExecutions; t++)
+	{
+		const EXECUTION& execution = m_executions[t];
+		if (topFinished && t == numExecutions - 1)
+		{
+			stack.push_back(execution.functionId);
+			continue;
+		}
+
+		// root frame first
+		for (asUINT level = execution.context->GetCallstackSize(); level > 0; level--)
+		{
+			const asIScriptFunction* pFunction = execution.context->GetFunction(level - 1);
+			if (pFunction)
+				stack.push_back(pFunction->GetId());
+		}
+	}
+}
+
+std::string ETHScriptProfiler::GetFrameName(const int functionId)
+{
+	const asIScriptFunction* pFunction = m_engine->GetFunctionDescriptorById(functionId);
+	if (!pFunction)
+		return "?";
+
+	std::string name;
+	const char* objectName = pFunction->GetObjectName();
+	if (objectName && objectName[0] != '\0')
+	{
+		name += objectName;
+		name += "::";
+	}
+	name += pFunction->GetName();
+	return name;
+}
+
+bool ETHScriptProfiler::Stop()
+{
+	if (!m_enabled)
+		return false;
+	m_enabled = false;
+
+	std::ofstream ofs(m_outputFile.c_str());
+	const bool written = ofs.is_open();
+	if (written)
+	{
+		std::map<int, std::string> frameNames;
+		for (std::map<CALL_STACK, unsigned long>::const_iterator iter = m_samples.begin(); iter != m_samples.end(); ++iter)
+		{
+			const CALL_STACK& stack = iter->first;
+			for (std::size_t t = 0; t < stack.size(); t++)
+			{
+				std::map<int, std::string>::iterator nameIter = frameNames.find(stack[t]);
+				if (nameIter == frameNames.end())
+					nameIter = frameNames.insert(std::make_pair(stack[t], GetFrameName(stack[t]))).first;
+				if (t > 0)
+					ofs << ';';
+				ofs << nameIter->second;
+			}
+			ofs << ' ' << iter->second << std::endl;
+		}
+		ofs.close();
+
+		ETH_STREAM_DECL(ss) << GS_L("Script profile saved to ") << m_outputFile;
+		ETHResourceProvider::Log(ss.str(), Platform::Logger::INFO);
+	}
+	else
+	{
+		ETH_STREAM_DECL(ss) << GS_L("Failed while writing the script profile file ") << m_outputFile;
+		ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
+	}
+
+	m_executions.clear();
+	m_samples.clear();
+	m_video.reset();
+	m_engine = 0;
+	return written;
+}
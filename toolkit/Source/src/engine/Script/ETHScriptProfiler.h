@@ -0,0 +1,69 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_SCRIPT_PROFILER_H_
+#define ETH_SCRIPT_PROFILER_H_
+
+#include "../../angelscript/include/angelscript.h"
+#include "../ETHCommon.h"
+#include <vector>
+#include <map>
+
+/// Sampling profiler for script code. Every context run through ETHGlobal::ExecuteContext
+/// is tracked, and the line callback charges the milliseconds elapsed since the last sample
+/// to the script call stack running at that moment. Nested executions (e.g. entity
+/// constructors run while onSceneUpdate is adding entities) are charged under the stack
+/// that started them. The result is written in the collapsed-stack format read by flamegraph tools
+class ETHScriptProfiler
+{
+	typedef std::vector<int> CALL_STACK;
+
+	struct EXECUTION
+	{
+		asIScriptContext* context;
+		int functionId;
+	};
+
+	static bool m_enabled;
+	static str_type::string m_outputFile;
+	static gs2d::VideoPtr m_video;
+	static asIScriptEngine* m_engine;
+	static unsigned long m_lastSampleTime;
+	static std::vector<EXECUTION> m_executions;
+	static std::map<CALL_STACK, unsigned long> m_samples;
+
+	static void LineCallback(asIScriptContext* pContext, void* param);
+	static void Sample(const unsigned long now, const bool topFinished);
+	static void BuildCallStack(CALL_STACK& stack, const bool topFinished);
+	static std::string GetFrameName(const int functionId);
+
+public:
+	static void Start(const gs2d::VideoPtr& video, asIScriptEngine* pASEngine, const str_type::string& outputFile);
+	static void AttachContext(asIScriptContext* pContext);
+	static bool Stop();
+	static bool IsEnabled();
+
+	static void BeginExecution(asIScriptContext* pContext, const int functionId);
+	static void EndExecution();
+};
+
+#endif
@@ -21,9 +21,16 @@
 --------------------------------------------------------------------------------------*/
 
 #include "ETHScriptWrapper.h"
+#include "ETHScriptObjRegister.h"
 #include <math.h>
 #include "../addons/aswrappedcall.h"
 
+#ifdef ETH_NATIVE_MATH_CALLS
+
+#include "ETHScriptWrapper.Math.native.cpp"
+
+#else
+
 asDECLARE_FUNCTION_WRAPPERPR(__length2, ETHScriptWrapper::Math::Length, (const Vector2&), float);
 asDECLARE_FUNCTION_WRAPPERPR(__length3, ETHScriptWrapper::Math::Length, (const Vector3&), float);
 
@@ -50,3 +57,4 @@ void ETHScriptWrapper::Math::RegisterGlobals(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("vector2 multiply(const vector2 &in, const matrix4x4 &in)", asFUNCTION(__multiplyv2), asCALL_GENERIC); assert(r >= 0);
 }
 
+#endif
@@ -32,5 +32,8 @@ void ETHScriptWrapper::Math::RegisterGlobals(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("int sign(const int)", asFUNCTIONPR(Sign, (const int), int), asCALL_CDECL); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("float distance(const vector2 &in, const vector2 &in)", asFUNCTIONPR(Distance, (const Vector2 &, const Vector2 &), float), asCALL_CDECL); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("float distance(const vector3 &in, const vector3 &in)", asFUNCTIONPR(Distance, (const Vector3 &, const Vector3 &), float), asCALL_CDECL); assert(r >= 0);
+
+	r = pASEngine->RegisterGlobalFunction("vector3 multiply(const vector3 &in, const matrix4x4 &in)", asFUNCTIONPR(gs2d::math::Multiply, (const Vector3&, const Matrix4x4&), Vector3), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("vector2 multiply(const vector2 &in, const matrix4x4 &in)", asFUNCTIONPR(gs2d::math::Multiply, (const Vector2&, const Matrix4x4&), Vector2), asCALL_CDECL); assert(r >= 0);
 }
 
@@ -23,6 +23,7 @@
 #include "ETHScriptWrapper.h"
 #include "../Shader/ETHShaderManager.h"
 #include "../Entity/ETHRenderEntity.h"
+#include "../../addons/scriptarray.h"
 
 ETHScriptWrapper::ETH_NEXT_SCENE::ETH_NEXT_SCENE()
 {
@@ -451,6 +452,13 @@ void ETHScriptWrapper::GetIntersectingEntities(const Vector2 &v2Here, ETHEntityA
 	m_pScene->GetIntersectingEntities(v2Here, outVector, screenSpace);
 }
 
+void ETHScriptWrapper::GetEntitiesInArea(const Vector2 &v2Min, const Vector2 &v2Max, ETHEntityArray &outVector, const bool screenSpace)
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetEntitiesInArea")))
+		return;
+	m_pScene->GetEntitiesInArea(v2Min, v2Max, outVector, screenSpace);
+}
+
 int ETHScriptWrapper::GetNumRenderedEntities()
 {
 	if (WarnIfRunsInMainFunction(GS_L("GetNumRenderedEntities")))
@@ -486,6 +494,9 @@ void ETHScriptWrapper::ResolveJoints()
 
 bool ETHScriptWrapper::LoadScene(const str_type::string &escFile, const Vector2& bucketSize)
 {
+	// coroutines may hold entities and state of the scene being left
+	m_coroutineScheduler.AbortAll();
+
 	if (!IsPersistentResources())
 	{
 		if (escFile != m_sceneFileName)
@@ -640,6 +651,99 @@ bool ETHScriptWrapper::GetContactEntities(const Vector2& a, const Vector2& b, ET
 	return m_pScene->GetSimulator().GetContactEntities(a, b, entities);
 }
 
+unsigned int ETHScriptWrapper::CreatePhysicsQueryFilter(const str_type::string& semicolonSeparatedIgnoreList)
+{
+	if (WarnIfRunsInMainFunction(GS_L("CreatePhysicsQueryFilter")))
+		return 0;
+	return m_pScene->GetSimulator().CreateQueryFilter(semicolonSeparatedIgnoreList);
+}
+
+bool ETHScriptWrapper::IgnoreEntityInPhysicsQueryFilter(const unsigned int filter, const int entityID)
+{
+	if (WarnIfRunsInMainFunction(GS_L("IgnoreEntityInPhysicsQueryFilter")))
+		return false;
+	return m_pScene->GetSimulator().IgnoreEntityInQueryFilter(filter, entityID);
+}
+
+bool ETHScriptWrapper::DestroyPhysicsQueryFilter(const unsigned int filter)
+{
+	if (WarnIfRunsInMainFunction(GS_L("DestroyPhysicsQueryFilter")))
+		return false;
+	return m_pScene->GetSimulator().DestroyQueryFilter(filter);
+}
+
+unsigned int ETHScriptWrapper::CastRays(CScriptArray* a, CScriptArray* b, CScriptArray* hits,
+										CScriptArray* points, CScriptArray* normals, const unsigned int filter)
+{
+	if (WarnIfRunsInMainFunction(GS_L("CastRays")))
+		return 0;
+	if (!a || !b || !hits || !points || !normals)
+		return 0;
+
+	const asUINT numRays = Min(a->GetSize(), b->GetSize());
+	hits->Resize(numRays);
+	points->Resize(numRays);
+	normals->Resize(numRays);
+	if (numRays == 0)
+		return 0;
+
+	// script arrays keep each vector2 apart, so gather them into buffers that outlive the call
+	static std::vector<Vector2> origins, targets, contactPoints, contactNormals;
+	static std::vector<ETHEntity*> closest;
+	origins.resize(numRays); targets.resize(numRays);
+	contactPoints.resize(numRays); contactNormals.resize(numRays);
+	closest.resize(numRays);
+	for (asUINT t = 0; t < numRays; t++)
+	{
+		origins[t] = *static_cast<const Vector2*>(a->At(t));
+		targets[t] = *static_cast<const Vector2*>(b->At(t));
+	}
+
+	const unsigned int numHits = static_cast<unsigned int>(m_pScene->GetSimulator().CastRays(
+		&origins[0], &targets[0], numRays, &closest[0], &contactPoints[0], &contactNormals[0], filter));
+
+	for (asUINT t = 0; t < numRays; t++)
+	{
+		ETHEntity** handle = static_cast<ETHEntity**>(hits->At(t));
+		if (*handle)
+			(*handle)->Release();
+		*handle = closest[t];
+		if (*handle)
+		{
+			(*handle)->AddRef();
+			*static_cast<Vector2*>(points->At(t)) = contactPoints[t];
+			*static_cast<Vector2*>(normals->At(t)) = contactNormals[t];
+		}
+	}
+	return numHits;
+}
+
+unsigned int ETHScriptWrapper::QueryAABBs(CScriptArray* min, CScriptArray* max, ETHEntityArray* entities,
+										  CScriptArray* counts, const unsigned int filter)
+{
+	if (WarnIfRunsInMainFunction(GS_L("QueryAABBs")))
+		return 0;
+	if (!min || !max || !entities || !counts)
+		return 0;
+
+	const asUINT numBoxes = Min(min->GetSize(), max->GetSize());
+	counts->Resize(numBoxes);
+	if (numBoxes == 0)
+		return 0;
+
+	static std::vector<Vector2> lowerBounds, upperBounds;
+	lowerBounds.resize(numBoxes); upperBounds.resize(numBoxes);
+	for (asUINT t = 0; t < numBoxes; t++)
+	{
+		lowerBounds[t] = *static_cast<const Vector2*>(min->At(t));
+		upperBounds[t] = *static_cast<const Vector2*>(max->At(t));
+	}
+
+	// uint arrays are contiguous, so the counts go straight into the script array
+	return static_cast<unsigned int>(m_pScene->GetSimulator().QueryAABBs(
+		&lowerBounds[0], &upperBounds[0], numBoxes, *entities, static_cast<unsigned int*>(counts->At(0)), filter));
+}
+
 bool ETHScriptWrapper::IsFixedTimeStep()
 {
 	if (WarnIfRunsInMainFunction(GS_L("IsFixedTimeStep")))
@@ -668,6 +772,83 @@ void ETHScriptWrapper::SetFixedTimeStepValue(const float value)
 	m_pScene->GetSimulator().SetFixedTimeStepValue(value);
 }
 
+bool ETHScriptWrapper::IsTimeStepAccumulated()
+{
+	if (WarnIfRunsInMainFunction(GS_L("IsTimeStepAccumulated")))
+		return false;
+	return m_pScene->GetSimulator().IsTimeStepAccumulated();
+}
+
+void ETHScriptWrapper::SetTimeStepAccumulation(const bool enable)
+{
+	if (WarnIfRunsInMainFunction(GS_L("SetTimeStepAccumulation")))
+		return;
+	m_pScene->GetSimulator().SetTimeStepAccumulation(enable);
+}
+
+unsigned int ETHScriptWrapper::GetMaxPhysicsSubSteps()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetMaxPhysicsSubSteps")))
+		return 0;
+	return m_pScene->GetSimulator().GetMaxSubSteps();
+}
+
+void ETHScriptWrapper::SetMaxPhysicsSubSteps(const unsigned int maxSubSteps)
+{
+	if (WarnIfRunsInMainFunction(GS_L("SetMaxPhysicsSubSteps")))
+		return;
+	m_pScene->GetSimulator().SetMaxSubSteps(maxSubSteps);
+}
+
+bool ETHScriptWrapper::IsAsyncPhysicsStepping()
+{
+	if (WarnIfRunsInMainFunction(GS_L("IsAsyncPhysicsStepping")))
+		return false;
+	return m_pScene->GetSimulator().IsAsyncStepping();
+}
+
+void ETHScriptWrapper::SetAsyncPhysicsStepping(const bool enable)
+{
+	if (WarnIfRunsInMainFunction(GS_L("SetAsyncPhysicsStepping")))
+		return;
+	m_pScene->GetSimulator().SetAsyncStepping(enable);
+}
+
+unsigned int ETHScriptWrapper::GetPhysicsSolverThreads()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetPhysicsSolverThreads")))
+		return 0;
+	return m_pScene->GetSimulator().GetNumSolverThreads();
+}
+
+void ETHScriptWrapper::SetPhysicsSolverThreads(const unsigned int numThreads)
+{
+	if (WarnIfRunsInMainFunction(GS_L("SetPhysicsSolverThreads")))
+		return;
+	m_pScene->GetSimulator().SetNumSolverThreads(numThreads);
+}
+
+unsigned int ETHScriptWrapper::SavePhysicsSnapshot()
+{
+	if (WarnIfRunsInMainFunction(GS_L("SavePhysicsSnapshot")))
+		return 0;
+	return m_pScene->GetSimulator().SaveSnapshot();
+}
+
+bool ETHScriptWrapper::RestorePhysicsSnapshot(const unsigned int snapshot)
+{
+	if (WarnIfRunsInMainFunction(GS_L("RestorePhysicsSnapshot")))
+		return false;
+	return m_pScene->GetSimulator().RestoreSnapshot(snapshot);
+}
+
+bool ETHScriptWrapper::DeletePhysicsSnapshot(const unsigned int snapshot)
+{
+	if (WarnIfRunsInMainFunction(GS_L("DeletePhysicsSnapshot")))
+		return false;
+	return m_pScene->GetSimulator().DeleteSnapshot(snapshot);
+}
+
 void ETHScriptWrapper::UsePixelShaders(const bool enable)
 {
 	if (!m_provider->GetShaderManager()->IsPixelLightingSupported() && enable)
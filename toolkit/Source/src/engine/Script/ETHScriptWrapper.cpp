@@ -56,6 +56,7 @@ bool ETHScriptWrapper::m_persistentResources = false;
 ETHScriptWrapper::Math ETHScriptWrapper::m_math;
 unsigned long ETHScriptWrapper::m_lastFrameElapsedTime = 1;
 ETHEntityCache ETHScriptWrapper::m_entityCache;
+ETHCoroutineScheduler ETHScriptWrapper::m_coroutineScheduler;
 ETHScriptWrapper::GARBAGE_COLLECT_MODE ETHScriptWrapper::m_gcMode = ETHScriptWrapper::ONE_STEP;
 bool ETHScriptWrapper::m_richLighting = false;
 
@@ -125,6 +126,16 @@ void ETHScriptWrapper::PlayParticleSystem(ETHEntity *pEntity, const unsigned int
 	pEntity->PlayParticleSystem(n, m_pScene->GetZAxisDirection());
 }
 
+void ETHScriptWrapper::FastForwardParticleSystem(ETHEntity *pEntity, const unsigned int n, const unsigned int milliseconds)
+{
+	pEntity->FastForwardParticleSystem(n, milliseconds, m_pScene->GetZAxisDirection());
+}
+
+void ETHScriptWrapper::SetParticleSystemSeed(ETHEntity *pEntity, const unsigned int n, const unsigned int seed)
+{
+	pEntity->SetParticleSystemSeed(n, seed, m_pScene->GetZAxisDirection());
+}
+
 void ETHScriptWrapper::SetPosition(ETHEntity *pEntity, const Vector3 &v3Pos)
 {
 	pEntity->SetPosition(v3Pos, m_pScene->GetBucketManager());
@@ -145,6 +156,16 @@ void ETHScriptWrapper::AddToPositionXY(ETHEntity *pEntity, const Vector2 &v2Pos)
 	pEntity->AddToPositionXY(v2Pos * m_provider->GetGlobalScaleManager()->GetScale(), m_pScene->GetBucketManager());
 }
 
+void ETHScriptWrapper::AddToPositionArray(ETHEntityArray *pArray, const Vector3 &v3Pos)
+{
+	pArray->addToPosition(v3Pos * m_provider->GetGlobalScaleManager()->GetScale(), m_pScene->GetBucketManager());
+}
+
+void ETHScriptWrapper::AddToPositionXYArray(ETHEntityArray *pArray, const Vector2 &v2Pos)
+{
+	pArray->addToPositionXY(v2Pos * m_provider->GetGlobalScaleManager()->GetScale(), m_pScene->GetBucketManager());
+}
+
 Vector2 ETHScriptWrapper::GetScreenRectMin(ETHEntity *pEntity)
 {
 	return pEntity->GetScreenRectMin(*m_pScene->GetSceneProperties());
@@ -191,6 +212,54 @@ void ETHScriptWrapper::SetFastGarbageCollector(const bool enable)
 	m_gcMode = enable ? ONE_STEP : FULL_CYCLE;
 }
 
+bool ETHScriptWrapper::StartCoroutine(const str_type::string &functionName)
+{
+	return StartCoroutine(functionName, 0);
+}
+
+bool ETHScriptWrapper::StartCoroutine(const str_type::string &functionName, ETHEntity *entity)
+{
+	bool started = false;
+
+	// coroutines belong to the scene and would be aborted before ever running
+	if (!WarnIfRunsInMainFunction(GS_L("StartCoroutine")))
+	{
+		const int functionId = GetFunctionId(m_pASModule, functionName);
+		if (functionId >= 0)
+		{
+			started = m_coroutineScheduler.Start(m_pASEngine, functionId, entity);
+		}
+		else
+		{
+			ETH_STREAM_DECL(ss) << GS_L("StartCoroutine: function not found (") << functionName << GS_L(")");
+			m_provider->Log(ss.str(), Platform::Logger::ERROR);
+		}
+	}
+
+	// the coroutine context holds its own reference to the entity
+	if (entity)
+		entity->Release();
+	return started;
+}
+
+void ETHScriptWrapper::YieldCoroutine()
+{
+	if (!m_coroutineScheduler.Suspend(asGetActiveContext()))
+	{
+		m_provider->Log(GS_L("Yield: only functions started with StartCoroutine can yield"), Platform::Logger::WARNING);
+	}
+}
+
+void ETHScriptWrapper::SetCoroutineTimeBudget(const float milliseconds)
+{
+	m_coroutineScheduler.SetTimeBudget(milliseconds);
+}
+
+unsigned int ETHScriptWrapper::GetNumCoroutines()
+{
+	return static_cast<unsigned int>(m_coroutineScheduler.GetNumCoroutines());
+}
+
 void ETHScriptWrapper::SetHighEndDevice(const bool highEnd)
 {
 	m_highEndDevice = highEnd;
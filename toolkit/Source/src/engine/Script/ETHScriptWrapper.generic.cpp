@@ -39,6 +39,10 @@ asDECLARE_FUNCTION_OBJ_WRAPPER(__SetPositionXY,      ETHScriptWrapper::SetPositi
 asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPosition,      ETHScriptWrapper::AddToPosition, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPositionXY,    ETHScriptWrapper::AddToPositionXY, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__PlayParticleSystem, ETHScriptWrapper::PlayParticleSystem, true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__FastForwardParticleSystem, ETHScriptWrapper::FastForwardParticleSystem, true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__SetParticleSystemSeed,     ETHScriptWrapper::SetParticleSystemSeed, true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPositionArray,        ETHScriptWrapper::AddToPositionArray, true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPositionXYArray,      ETHScriptWrapper::AddToPositionXYArray, true);
 
 asDECLARE_FUNCTION_WRAPPERPR(__SeekEntityStr,   ETHScriptWrapper::SeekEntity, (const str_type::string&), ETHEntity *);
 asDECLARE_FUNCTION_WRAPPERPR(__SeekEntityInt,   ETHScriptWrapper::SeekEntity, (const int), ETHEntity *);
@@ -161,6 +165,7 @@ asDECLARE_FUNCTION_WRAPPER(__GetEntityArray,          ETHScriptWrapper::GetEntit
 asDECLARE_FUNCTION_WRAPPER(__GetEntitiesFromBucket,   ETHScriptWrapper::GetEntityArrayFromBucket);
 asDECLARE_FUNCTION_WRAPPER(__GetVisibleEntities,      ETHScriptWrapper::GetVisibleEntities);
 asDECLARE_FUNCTION_WRAPPER(__GetIntersectingEntities, ETHScriptWrapper::GetIntersectingEntities);
+asDECLARE_FUNCTION_WRAPPER(__GetEntitiesInArea,       ETHScriptWrapper::GetEntitiesInArea);
 asDECLARE_FUNCTION_WRAPPER(__GetBucket,               ETHScriptWrapper::GetBucket);
 asDECLARE_FUNCTION_WRAPPER(__GetAllEntitiesInScene,   ETHScriptWrapper::GetAllEntitiesInScene);
 
@@ -195,6 +200,10 @@ asDECLARE_FUNCTION_WRAPPER(__IsPersistentResources,      ETHScriptWrapper::IsPer
 asDECLARE_FUNCTION_WRAPPER(__ReleaseResources,           ETHScriptWrapper::ReleaseResources);
 asDECLARE_FUNCTION_WRAPPER(__ResolveJoints,              ETHScriptWrapper::ResolveJoints);
 asDECLARE_FUNCTION_WRAPPER(__SetFastGarbageCollector,    ETHScriptWrapper::SetFastGarbageCollector);
+asDECLARE_FUNCTION_WRAPPERPR(__StartCoroutine,       ETHScriptWrapper::StartCoroutine, (const str_type::string&), bool);
+asDECLARE_FUNCTION_WRAPPER(__YieldCoroutine,         ETHScriptWrapper::YieldCoroutine);
+asDECLARE_FUNCTION_WRAPPER(__SetCoroutineTimeBudget, ETHScriptWrapper::SetCoroutineTimeBudget);
+asDECLARE_FUNCTION_WRAPPER(__GetNumCoroutines,       ETHScriptWrapper::GetNumCoroutines);
 asDECLARE_FUNCTION_WRAPPER(__GetStringFromFileInPackage, ETHScriptWrapper::GetStringFromFileInPackage);
 asDECLARE_FUNCTION_WRAPPER(__FileInPackageExists,        ETHScriptWrapper::FileInPackageExists);
 asDECLARE_FUNCTION_WRAPPER(__FileExists,                 ETHScriptWrapper::FileExists);
@@ -212,11 +221,27 @@ asDECLARE_FUNCTION_WRAPPER(__GetTimeStepScale, ETHScriptWrapper::GetTimeStepScal
 asDECLARE_FUNCTION_WRAPPERPR(__GetClosestContact,   ETHScriptWrapper::GetClosestContact, (const Vector2&, const Vector2&, Vector2&, Vector2&),                          ETHEntity*);
 asDECLARE_FUNCTION_WRAPPERPR(__GetClosestContactEx, ETHScriptWrapper::GetClosestContact, (const Vector2&, const Vector2&, Vector2&, Vector2&, const str_type::string&), ETHEntity*);
 asDECLARE_FUNCTION_WRAPPER(__GetContactEntities, ETHScriptWrapper::GetContactEntities);
+asDECLARE_FUNCTION_WRAPPER(__CreatePhysicsQueryFilter,			ETHScriptWrapper::CreatePhysicsQueryFilter);
+asDECLARE_FUNCTION_WRAPPER(__IgnoreEntityInPhysicsQueryFilter,	ETHScriptWrapper::IgnoreEntityInPhysicsQueryFilter);
+asDECLARE_FUNCTION_WRAPPER(__DestroyPhysicsQueryFilter,			ETHScriptWrapper::DestroyPhysicsQueryFilter);
+asDECLARE_FUNCTION_WRAPPER(__CastRays,							ETHScriptWrapper::CastRays);
+asDECLARE_FUNCTION_WRAPPER(__QueryAABBs,						ETHScriptWrapper::QueryAABBs);
 
 asDECLARE_FUNCTION_WRAPPER(__IsFixedTimeStep,				ETHScriptWrapper::IsFixedTimeStep);
 asDECLARE_FUNCTION_WRAPPER(__GetFixedTimeStepValue,			ETHScriptWrapper::GetFixedTimeStepValue);
 asDECLARE_FUNCTION_WRAPPER(__SetFixedTimeStep,				ETHScriptWrapper::SetFixedTimeStep);
 asDECLARE_FUNCTION_WRAPPER(__SetFixedTimeStepValue,			ETHScriptWrapper::SetFixedTimeStepValue);
+asDECLARE_FUNCTION_WRAPPER(__IsTimeStepAccumulated,			ETHScriptWrapper::IsTimeStepAccumulated);
+asDECLARE_FUNCTION_WRAPPER(__SetTimeStepAccumulation,		ETHScriptWrapper::SetTimeStepAccumulation);
+asDECLARE_FUNCTION_WRAPPER(__GetMaxPhysicsSubSteps,			ETHScriptWrapper::GetMaxPhysicsSubSteps);
+asDECLARE_FUNCTION_WRAPPER(__SetMaxPhysicsSubSteps,			ETHScriptWrapper::SetMaxPhysicsSubSteps);
+asDECLARE_FUNCTION_WRAPPER(__IsAsyncPhysicsStepping,		ETHScriptWrapper::IsAsyncPhysicsStepping);
+asDECLARE_FUNCTION_WRAPPER(__SetAsyncPhysicsStepping,		ETHScriptWrapper::SetAsyncPhysicsStepping);
+asDECLARE_FUNCTION_WRAPPER(__GetPhysicsSolverThreads,		ETHScriptWrapper::GetPhysicsSolverThreads);
+asDECLARE_FUNCTION_WRAPPER(__SetPhysicsSolverThreads,		ETHScriptWrapper::SetPhysicsSolverThreads);
+asDECLARE_FUNCTION_WRAPPER(__SavePhysicsSnapshot,			ETHScriptWrapper::SavePhysicsSnapshot);
+asDECLARE_FUNCTION_WRAPPER(__RestorePhysicsSnapshot,		ETHScriptWrapper::RestorePhysicsSnapshot);
+asDECLARE_FUNCTION_WRAPPER(__DeletePhysicsSnapshot,			ETHScriptWrapper::DeletePhysicsSnapshot);
 asDECLARE_FUNCTION_WRAPPER(__GetCurrentPhysicsTimeStepMS,	ETHScriptWrapper::GetCurrentPhysicsTimeStepMS);
 
 asDECLARE_FUNCTION_WRAPPER(__SetFixedHeight, ETHScriptWrapper::SetFixedHeight);
@@ -260,6 +285,15 @@ static void __DeleteEntity(asIScriptGeneric *gen)
 	gen->SetReturnObject(r);
 }
 
+static void __StartCoroutineEntity(asIScriptGeneric *gen)
+{
+	const str_type::string *functionName = (str_type::string*)gen->GetArgAddress(0);
+	ETHEntity *entity = (ETHEntity*)gen->GetArgObject(1);
+	if (entity)
+		entity->AddRef();
+	gen->SetReturnByte(ETHScriptWrapper::StartCoroutine(*functionName, entity));
+}
+
 void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 {
 	int r;
@@ -277,10 +311,14 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetPositionXY(const vector2 &in)",   asFUNCTION(__SetPositionXY),      asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToPosition(const vector3 &in)",   asFUNCTION(__AddToPosition),      asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToPositionXY(const vector2 &in)", asFUNCTION(__AddToPositionXY),    asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void addToPosition(const vector3 &in)",   asFUNCTION(__AddToPositionArray),   asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void addToPositionXY(const vector2 &in)", asFUNCTION(__AddToPositionXYArray), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "vector2 GetCurrentBucket() const",        asFUNCTION(__GetCurrentBucket),   asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "vector2 GetScreenRectMin() const",        asFUNCTION(__GetScreenRectMin),   asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "vector2 GetScreenRectMax() const",        asFUNCTION(__GetScreenRectMax),   asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void PlayParticleSystem(const uint)",     asFUNCTION(__PlayParticleSystem), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void FastForwardParticleSystem(const uint n, const uint milliseconds)", asFUNCTION(__FastForwardParticleSystem), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetParticleSystemSeed(const uint n, const uint seed)",            asFUNCTION(__SetParticleSystemSeed),     asCALL_GENERIC); assert(r >= 0);
 
 	r = pASEngine->RegisterGlobalFunction("ETHEntity @SeekEntity(const string &in)", asFUNCTION(__SeekEntityStr), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("ETHEntity @SeekEntity(const int)",        asFUNCTION(__SeekEntityInt), asCALL_GENERIC); assert(r >= 0);
@@ -402,6 +440,7 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("bool GetEntitiesFromBucket(const vector2 &in, ETHEntityArray &)",               asFUNCTION(__GetEntitiesFromBucket),   asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void GetVisibleEntities(ETHEntityArray &)",                                     asFUNCTION(__GetVisibleEntities),      asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void GetIntersectingEntities(const vector2 &in, ETHEntityArray &, const bool)", asFUNCTION(__GetIntersectingEntities), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void GetEntitiesInArea(const vector2 &in, const vector2 &in, ETHEntityArray &, const bool)", asFUNCTION(__GetEntitiesInArea), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("vector2 GetBucket(const vector2 &in)",                                          asFUNCTION(__GetBucket),               asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool GetAllEntitiesInScene(ETHEntityArray &)",                                  asFUNCTION(__GetAllEntitiesInScene),   asCALL_GENERIC); assert(r >= 0);
 
@@ -438,6 +477,12 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("void SetFastGarbageCollector(const bool)", asFUNCTION(__SetFastGarbageCollector), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool IsHighEndDevice()",                   asFUNCTION(__IsHighEndDevice),         asCALL_GENERIC); assert(r >= 0);
 
+	r = pASEngine->RegisterGlobalFunction("bool StartCoroutine(const string &in)",           asFUNCTION(__StartCoroutine),         asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool StartCoroutine(const string &in, ETHEntity@)", asFUNCTION(__StartCoroutineEntity), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void Yield()",                                     asFUNCTION(__YieldCoroutine),         asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetCoroutineTimeBudget(const float)",         asFUNCTION(__SetCoroutineTimeBudget), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetNumCoroutines()",                          asFUNCTION(__GetNumCoroutines),       asCALL_GENERIC); assert(r >= 0);
+
 	r = pASEngine->RegisterGlobalFunction("string GetStringFromFileInPackage(const string &in)", asFUNCTION(__GetStringFromFileInPackage), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool FileInPackageExists(const string &in)",          asFUNCTION(__FileInPackageExists),        asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool FileExists(const string &in)",                   asFUNCTION(__FileExists),                 asCALL_GENERIC); assert(r >= 0);
@@ -454,11 +499,27 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("ETHEntity@ GetClosestContact(const vector2 &in, const vector2 &in, vector2 &out, vector2 &out)", asFUNCTION(__GetClosestContact),  asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("ETHEntity@ GetClosestContact(const vector2 &in, const vector2 &in, vector2 &out, vector2 &out, const string &in)", asFUNCTION(__GetClosestContactEx),  asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool GetContactEntities(const vector2 &in, const vector2 &in, ETHEntityArray@)",                 asFUNCTION(__GetContactEntities), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint CreatePhysicsQueryFilter(const string &in)",					 asFUNCTION(__CreatePhysicsQueryFilter),		 asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool IgnoreEntityInPhysicsQueryFilter(const uint, const int)",		 asFUNCTION(__IgnoreEntityInPhysicsQueryFilter), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool DestroyPhysicsQueryFilter(const uint)",						 asFUNCTION(__DestroyPhysicsQueryFilter),		 asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint CastRays(vector2[]@, vector2[]@, ETHEntity@[]@, vector2[]@, vector2[]@, const uint)", asFUNCTION(__CastRays), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint QueryAABBs(vector2[]@, vector2[]@, ETHEntityArray@, uint[]@, const uint)", asFUNCTION(__QueryAABBs), asCALL_GENERIC); assert(r >= 0);
 
 	r = pASEngine->RegisterGlobalFunction("bool IsFixedTimeStep()",					 asFUNCTION(__IsFixedTimeStep),			    asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("float GetFixedTimeStepValue()",			 asFUNCTION(__GetFixedTimeStepValue),	    asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetFixedTimeStep(const bool)",		 asFUNCTION(__SetFixedTimeStep),			asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetFixedTimeStepValue(const float)", asFUNCTION(__SetFixedTimeStepValue),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool IsTimeStepAccumulated()",			 asFUNCTION(__IsTimeStepAccumulated),		asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetTimeStepAccumulation(const bool)", asFUNCTION(__SetTimeStepAccumulation),    asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetMaxPhysicsSubSteps()",			 asFUNCTION(__GetMaxPhysicsSubSteps),		asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetMaxPhysicsSubSteps(const uint)",	 asFUNCTION(__SetMaxPhysicsSubSteps),		asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool IsAsyncPhysicsStepping()",			 asFUNCTION(__IsAsyncPhysicsStepping),		asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetAsyncPhysicsStepping(const bool)", asFUNCTION(__SetAsyncPhysicsStepping),    asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetPhysicsSolverThreads()",			 asFUNCTION(__GetPhysicsSolverThreads),		asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetPhysicsSolverThreads(const uint)", asFUNCTION(__SetPhysicsSolverThreads),    asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint SavePhysicsSnapshot()",				 asFUNCTION(__SavePhysicsSnapshot),			asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool RestorePhysicsSnapshot(const uint)",	 asFUNCTION(__RestorePhysicsSnapshot),		asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool DeletePhysicsSnapshot(const uint)",	 asFUNCTION(__DeletePhysicsSnapshot),		asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("float GetCurrentPhysicsTimeStepMS()",	 asFUNCTION(__GetCurrentPhysicsTimeStepMS), asCALL_GENERIC); assert(r >= 0);
 
 	r = pASEngine->RegisterGlobalFunction("void SetFixedHeight(const float)", asFUNCTION(__SetFixedHeight), asCALL_GENERIC); assert(r >= 0);
@@ -29,6 +29,9 @@
 #include "../Util/ETHInput.h"
 #include "../Entity/ETHEntityCache.h"
 #include "../Shader/ETHBackBufferTargetManager.h"
+#include "ETHCoroutineScheduler.h"
+
+class CScriptArray;
 
 class ETHScriptWrapper
 {
@@ -81,6 +84,7 @@ public:
 	static int m_onResumeFunctionId;
 
 	static ETHEntityCache m_entityCache;
+	static ETHCoroutineScheduler m_coroutineScheduler;
 
 	class ETH_NEXT_SCENE
 	{
@@ -153,6 +157,12 @@ public:
 	static Vector2 GetScreenRectMin(ETHEntity *pEntity);
 	static Vector2 GetScreenRectMax(ETHEntity *pEntity);
 	static void PlayParticleSystem(ETHEntity *pEntity, const unsigned int n);
+	static void FastForwardParticleSystem(ETHEntity *pEntity, const unsigned int n, const unsigned int milliseconds);
+	static void SetParticleSystemSeed(ETHEntity *pEntity, const unsigned int n, const unsigned int seed);
+
+	// ETHEntityArray bulk methods wrappers
+	static void AddToPositionArray(ETHEntityArray *pArray, const Vector3 &v3Pos);
+	static void AddToPositionXYArray(ETHEntityArray *pArray, const Vector2 &v2Pos);
 	// global wraps 
 
 	static void HideCursor(const bool hide);
@@ -251,6 +261,7 @@ public:
 	static void EnableRealTimeShadows(const bool enable);
 	static void GetVisibleEntities(ETHEntityArray &entityArray);
 	static void GetIntersectingEntities(const Vector2 &v2Here, ETHEntityArray &outVector, const bool screenSpace);
+	static void GetEntitiesInArea(const Vector2 &v2Min, const Vector2 &v2Max, ETHEntityArray &outVector, const bool screenSpace);
 	static int GetNumRenderedEntities();
 	static void SetBorderBucketsDrawing(const bool enable);
 	static bool IsDrawingBorderBuckets();
@@ -271,6 +282,12 @@ public:
 	static void GarbageCollect(const GARBAGE_COLLECT_MODE mode, asIScriptEngine* engine);
 	static void SetFastGarbageCollector(const bool enable);
 
+	static bool StartCoroutine(const str_type::string &functionName);
+	static bool StartCoroutine(const str_type::string &functionName, ETHEntity *entity);
+	static void YieldCoroutine();
+	static void SetCoroutineTimeBudget(const float milliseconds);
+	static unsigned int GetNumCoroutines();
+
 	static void SetHighEndDevice(const bool highEnd);
 	static bool IsHighEndDevice();
 
@@ -302,11 +319,27 @@ public:
 	static float GetFixedTimeStepValue();
 	static void SetFixedTimeStep(const bool enable);
 	static void SetFixedTimeStepValue(const float value);
+	static bool IsTimeStepAccumulated();
+	static void SetTimeStepAccumulation(const bool enable);
+	static unsigned int GetMaxPhysicsSubSteps();
+	static void SetMaxPhysicsSubSteps(const unsigned int maxSubSteps);
+	static bool IsAsyncPhysicsStepping();
+	static void SetAsyncPhysicsStepping(const bool enable);
+	static unsigned int GetPhysicsSolverThreads();
+	static void SetPhysicsSolverThreads(const unsigned int numThreads);
+	static unsigned int SavePhysicsSnapshot();
+	static bool RestorePhysicsSnapshot(const unsigned int snapshot);
+	static bool DeletePhysicsSnapshot(const unsigned int snapshot);
 	static float GetCurrentPhysicsTimeStepMS();
 
 	static ETHEntity* GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal);
 	static ETHEntity* GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal, const str_type::string& semicolonSeparatedIgnoreList);
 	static bool GetContactEntities(const Vector2& a, const Vector2& b, ETHEntityArray& entities);
+	static unsigned int CreatePhysicsQueryFilter(const str_type::string& semicolonSeparatedIgnoreList);
+	static bool IgnoreEntityInPhysicsQueryFilter(const unsigned int filter, const int entityID);
+	static bool DestroyPhysicsQueryFilter(const unsigned int filter);
+	static unsigned int CastRays(CScriptArray* a, CScriptArray* b, CScriptArray* hits, CScriptArray* points, CScriptArray* normals, const unsigned int filter);
+	static unsigned int QueryAABBs(CScriptArray* min, CScriptArray* max, ETHEntityArray* entities, CScriptArray* counts, const unsigned int filter);
 
 	static void SetFixedHeight(const float height);
 	static void SetFixedWidth(const float width);
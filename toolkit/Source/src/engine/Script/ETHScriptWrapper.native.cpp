@@ -40,7 +40,11 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetPositionXY(const vector2 &in)", asFUNCTION(SetPositionXY), asCALL_CDECL_OBJFIRST); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToPosition(const vector3 &in)", asFUNCTION(AddToPosition), asCALL_CDECL_OBJFIRST); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void AddToPositionXY(const vector2 &in)", asFUNCTION(AddToPositionXY), asCALL_CDECL_OBJFIRST); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void addToPosition(const vector3 &in)", asFUNCTION(AddToPositionArray), asCALL_CDECL_OBJFIRST); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void addToPositionXY(const vector2 &in)", asFUNCTION(AddToPositionXYArray), asCALL_CDECL_OBJFIRST); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "vector2 GetCurrentBucket() const", asFUNCTION(GetCurrentBucket), asCALL_CDECL_OBJFIRST); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void FastForwardParticleSystem(const uint n, const uint milliseconds)", asFUNCTION(FastForwardParticleSystem), asCALL_CDECL_OBJFIRST); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntity", "void SetParticleSystemSeed(const uint n, const uint seed)", asFUNCTION(SetParticleSystemSeed), asCALL_CDECL_OBJFIRST); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("ETHEntity @SeekEntity(const string &in)", asFUNCTIONPR(SeekEntity, (const str_type::string&), ETHEntity*), asCALL_CDECL); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("ETHEntity @SeekEntity(const int)", asFUNCTIONPR(SeekEntity, (const int), ETHEntity*), asCALL_CDECL); assert(r >= 0);
 
@@ -169,6 +173,11 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("bool IsPersistentResources()",            asFUNCTION(IsPersistentResources),  asCALL_CDECL); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void ReleaseResources()",                 asFUNCTION(ReleaseResources),       asCALL_CDECL); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetFastGarbageCollector(const bool)", asFUNCTION(SetFastGarbageCollector), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool StartCoroutine(const string &in)", asFUNCTIONPR(StartCoroutine, (const str_type::string&), bool), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool StartCoroutine(const string &in, ETHEntity@)", asFUNCTIONPR(StartCoroutine, (const str_type::string&, ETHEntity*), bool), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void Yield()", asFUNCTION(YieldCoroutine), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetCoroutineTimeBudget(const float)", asFUNCTION(SetCoroutineTimeBudget), asCALL_CDECL); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetNumCoroutines()", asFUNCTION(GetNumCoroutines), asCALL_CDECL); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("uint GetLastFrameElapsedTime()", asFUNCTION(GetLastFrameElapsedTime), asCALL_CDECL); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("vector2 GetSpriteFrameSize(const string &in)",                    asFUNCTION(GetSpriteFrameSize), asCALL_CDECL); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetupSpriteRects(const string &in, const uint, const uint)", asFUNCTION(SetupSpriteRects),   asCALL_CDECL); assert(r >= 0);
@@ -24,6 +24,7 @@
 #include <iostream>
 
 #include "../Resource/ETHResourceProvider.h"
+#include "../Script/ETHScriptProfiler.h"
 
 #ifdef GS2D_STR_TYPE_WCHAR
 #	include "../addons/utf16/scriptbuilder.h"
@@ -32,19 +33,22 @@
 #endif
 
 namespace ETHGlobal {
-void ExecuteContext(asIScriptContext *pContext, const int id, const bool prepare)
+int ExecuteContext(asIScriptContext *pContext, const int id, const bool prepare)
 {
 	if (prepare)
 	{
-		if (pContext->Prepare(id) < 0)
+		const int r = pContext->Prepare(id);
+		if (r < 0)
 		{
 			ETH_STREAM_DECL(ss) << GS_L("(ExecuteContext) Couldn't prepare context for function  ID ") << id;
 			ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
-			return;
+			return r;
 		}
 	}
 
+	ETHScriptProfiler::BeginExecution(pContext, id);
 	const int r = pContext->Execute();
+	ETHScriptProfiler::EndExecution();
 	if (r != asEXECUTION_FINISHED)
 	{
 		if (r == asEXECUTION_EXCEPTION)
@@ -57,6 +61,7 @@ void ExecuteContext(asIScriptContext *pContext, const int id, const bool prepare
 			ShowMessage(ss.str(), ETH_ERROR);
 		}
 	}
+	return r;
 }
 
 void CheckFunctionSeekError(const int id, const str_type::string& function)
@@ -110,7 +115,7 @@ void PrintException(asIScriptContext *pContext)
 	ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
 }
 
-int FindCallbackFunction(asIScriptModule* pModule, const ETHScriptEntity* entity, const str_type::string& prefix, const Platform::Logger& logger)
+int FindCallbackFunction(asIScriptModule* pModule, const ETHScriptEntity* entity, const str_type::string& prefix)
 {
 	const str_type::string entityName = ETHGlobal::RemoveExtension(entity->GetEntityName().c_str());
 	str_type::stringstream funcName;
@@ -121,7 +126,7 @@ int FindCallbackFunction(asIScriptModule* pModule, const ETHScriptEntity* entity
 	{
 		str_type::stringstream ss;
 		ss << GS_L("ETHScene::FindCallbackFunction: found multiple functions named (") << funcName.str() << GS_L(").");
-		logger.Log(ss.str(), Platform::FileLogger::ERROR);
+		ETHResourceProvider::Log(ss.str(), Platform::FileLogger::ERROR);
 	}
 	return id;
 }
@@ -31,8 +31,8 @@ namespace ETHGlobal {
 	void CheckFunctionSeekError(const int id, const str_type::string& function);
 	void PrintException(asIScriptContext *pContext);
 	void ShowMessage(str_type::string message, const ETH_MESSAGE type);
-	void ExecuteContext(asIScriptContext *pContext, const int id, const bool prepare = true);
-	int FindCallbackFunction(asIScriptModule* pModule, const ETHScriptEntity* entity, const str_type::string& prefix, const Platform::Logger& logger);
+	int ExecuteContext(asIScriptContext *pContext, const int id, const bool prepare = true);
+	int FindCallbackFunction(asIScriptModule* pModule, const ETHScriptEntity* entity, const str_type::string& prefix);
 	bool RunEntityCallback(asIScriptContext* pContext, ETHScriptEntity* entity, const int id);
 } // namespace ETHGlobal
 
@@ -0,0 +1,226 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHWorkerThread.h"
+
+#if defined(WIN32) || defined(_WIN32)
+#include <windows.h>
+
+struct ETHWorkerThread::PLATFORM_DATA
+{
+	HANDLE thread;
+	HANDLE jobReady;
+	HANDLE jobDone;
+};
+
+static DWORD WINAPI WorkerThreadProc(LPVOID worker)
+{
+	return static_cast<DWORD>(reinterpret_cast<size_t>(ETHWorkerThread::ThreadEntry(worker)));
+}
+
+ETHWorkerThread::ETHWorkerThread() :
+	m_data(new PLATFORM_DATA),
+	m_job(0),
+	m_busy(false),
+	m_quit(false)
+{
+	m_data->jobReady = CreateEvent(NULL, FALSE, FALSE, NULL);
+	m_data->jobDone  = CreateEvent(NULL, FALSE, FALSE, NULL);
+	m_data->thread = CreateThread(NULL, 0, WorkerThreadProc, this, 0, NULL);
+}
+
+ETHWorkerThread::~ETHWorkerThread()
+{
+	Wait();
+	if (m_data->thread)
+	{
+		m_quit = true;
+		SetEvent(m_data->jobReady);
+		WaitForSingleObject(m_data->thread, INFINITE);
+		CloseHandle(m_data->thread);
+	}
+	CloseHandle(m_data->jobReady);
+	CloseHandle(m_data->jobDone);
+}
+
+void ETHWorkerThread::Run(Job* job)
+{
+	Wait();
+	if (!IsAsynchronous())
+	{
+		job->Execute();
+		return;
+	}
+	m_job = job;
+	m_busy = true;
+	SetEvent(m_data->jobReady);
+}
+
+void ETHWorkerThread::Wait()
+{
+	if (!m_busy)
+		return;
+	WaitForSingleObject(m_data->jobDone, INFINITE);
+	m_busy = false;
+	m_job = 0;
+}
+
+bool ETHWorkerThread::IsAsynchronous() const
+{
+	return (m_data->thread != NULL);
+}
+
+unsigned int ETHWorkerThread::GetNumProcessors()
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (info.dwNumberOfProcessors > 0) ? static_cast<unsigned int>(info.dwNumberOfProcessors) : 1;
+}
+
+void ETHWorkerThread::ThreadLoop()
+{
+	for (;;)
+	{
+		WaitForSingleObject(m_data->jobReady, INFINITE);
+		if (m_quit)
+			return;
+		m_job->Execute();
+		SetEvent(m_data->jobDone);
+	}
+}
+
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+struct ETHWorkerThread::PLATFORM_DATA
+{
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t condition;
+	bool created;
+	bool jobReady;
+	bool jobDone;
+};
+
+ETHWorkerThread::ETHWorkerThread() :
+	m_data(new PLATFORM_DATA),
+	m_job(0),
+	m_busy(false),
+	m_quit(false)
+{
+	m_data->jobReady = false;
+	m_data->jobDone = false;
+	pthread_mutex_init(&m_data->mutex, NULL);
+	pthread_cond_init(&m_data->condition, NULL);
+	m_data->created = (pthread_create(&m_data->thread, NULL, ThreadEntry, this) == 0);
+}
+
+ETHWorkerThread::~ETHWorkerThread()
+{
+	Wait();
+	if (m_data->created)
+	{
+		pthread_mutex_lock(&m_data->mutex);
+		m_quit = true;
+		pthread_cond_broadcast(&m_data->condition);
+		pthread_mutex_unlock(&m_data->mutex);
+		pthread_join(m_data->thread, NULL);
+	}
+	pthread_cond_destroy(&m_data->condition);
+	pthread_mutex_destroy(&m_data->mutex);
+}
+
+void ETHWorkerThread::Run(Job* job)
+{
+	Wait();
+	if (!IsAsynchronous())
+	{
+		job->Execute();
+		return;
+	}
+	pthread_mutex_lock(&m_data->mutex);
+	m_job = job;
+	m_busy = true;
+	m_data->jobDone = false;
+	m_data->jobReady = true;
+	pthread_cond_broadcast(&m_data->condition);
+	pthread_mutex_unlock(&m_data->mutex);
+}
+
+void ETHWorkerThread::Wait()
+{
+	if (!m_busy)
+		return;
+	pthread_mutex_lock(&m_data->mutex);
+	while (!m_data->jobDone)
+		pthread_cond_wait(&m_data->condition, &m_data->mutex);
+	m_busy = false;
+	m_job = 0;
+	pthread_mutex_unlock(&m_data->mutex);
+}
+
+bool ETHWorkerThread::IsAsynchronous() const
+{
+	return m_data->created;
+}
+
+unsigned int ETHWorkerThread::GetNumProcessors()
+{
+	const long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+	return (numProcessors > 0) ? static_cast<unsigned int>(numProcessors) : 1;
+}
+
+void ETHWorkerThread::ThreadLoop()
+{
+	pthread_mutex_lock(&m_data->mutex);
+	for (;;)
+	{
+		while (!m_data->jobReady && !m_quit)
+			pthread_cond_wait(&m_data->condition, &m_data->mutex);
+		if (m_quit)
+			break;
+		m_data->jobReady = false;
+		Job* job = m_job;
+		pthread_mutex_unlock(&m_data->mutex);
+
+		job->Execute();
+
+		pthread_mutex_lock(&m_data->mutex);
+		m_data->jobDone = true;
+		pthread_cond_broadcast(&m_data->condition);
+	}
+	pthread_mutex_unlock(&m_data->mutex);
+}
+
+#endif
+
+bool ETHWorkerThread::IsBusy() const
+{
+	return m_busy;
+}
+
+void* ETHWorkerThread::ThreadEntry(void* worker)
+{
+	static_cast<ETHWorkerThread*>(worker)->ThreadLoop();
+	return 0;
+}
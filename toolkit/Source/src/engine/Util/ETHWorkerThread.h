@@ -0,0 +1,72 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2012 Andre Santee
+ http://www.asantee.net/ethanon/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_WORKER_THREAD_H_
+#define ETH_WORKER_THREAD_H_
+
+#include <boost/shared_ptr.hpp>
+
+/// A single background thread that runs one job at a time. The owner hands
+/// a job over with Run() and must call Wait() before touching anything the
+/// job works on. If the thread can't be created, jobs run synchronously
+class ETHWorkerThread
+{
+public:
+	class Job
+	{
+	public:
+		virtual ~Job() {}
+		virtual void Execute() = 0;
+	};
+
+	ETHWorkerThread();
+	~ETHWorkerThread();
+
+	/// Start running the job in the background. Waits for the previous job to finish first
+	void Run(Job* job);
+
+	/// Block until the current job (if there's any) is finished
+	void Wait();
+
+	/// Return true if there's a job handed over that hasn't been waited for
+	bool IsBusy() const;
+
+	/// Return true if jobs really run in a background thread
+	bool IsAsynchronous() const;
+
+	/// Return the number of processors available to the application, or 1 if unknown
+	static unsigned int GetNumProcessors();
+
+	/// Thread entry point. 'worker' is the ETHWorkerThread that owns the thread
+	static void* ThreadEntry(void* worker);
+
+private:
+	struct PLATFORM_DATA;
+	boost::shared_ptr<PLATFORM_DATA> m_data;
+	Job* m_job;
+	bool m_busy;
+	bool m_quit;
+
+	void ThreadLoop();
+};
+
+#endif
@@ -49,8 +49,10 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Resource/ETHDirectories.cpp \
 	$(ENGINE_PATH)/Resource/ETHResourceManager.cpp \
 	$(ENGINE_PATH)/Resource/ETHResourceProvider.cpp \
+	$(ENGINE_PATH)/Resource/ETHParticleCache.cpp \
 	$(ENGINE_PATH)/Resource/ETHSpriteDensityManager.cpp \
 	$(ENGINE_PATH)/Util/ETHSpeedTimer.cpp \
+	$(ENGINE_PATH)/Util/ETHWorkerThread.cpp \
 	$(ENGINE_PATH)/Util/ETHASUtil.cpp \
 	$(ENGINE_PATH)/Util/ETHDateTime.cpp \
 	$(ENGINE_PATH)/Util/ETHInput.cpp \
@@ -77,6 +79,7 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Shader/ETHDefaultDynamicBackBuffer.cpp \
 	$(ENGINE_PATH)/Shader/ETHNoDynamicBackBuffer.cpp \
 	$(ENGINE_PATH)/Scene/ETHBucketManager.cpp \
+	$(ENGINE_PATH)/Scene/ETHSpatialIndex.cpp \
 	$(ENGINE_PATH)/Scene/ETHScene.cpp \
 	$(ENGINE_PATH)/Scene/ETHTempEntityHandler.cpp \
 	$(ENGINE_PATH)/Scene/ETHSceneProperties.cpp \
@@ -88,6 +91,12 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Script/ETHScriptObjRegister.generic.cpp \
 	$(ENGINE_PATH)/Script/ETHBinaryStream.cpp \
 	$(ENGINE_PATH)/Script/ETHEntityDestructorManager.cpp \
+	$(ENGINE_PATH)/Script/ETHGarbageCollectScheduler.cpp \
+	$(ENGINE_PATH)/Script/ETHCoroutineScheduler.cpp \
+	$(ENGINE_PATH)/Script/ETHJITCompiler.cpp \
+	$(ENGINE_PATH)/Script/ETHScriptProfiler.cpp \
+	$(ENGINE_PATH)/Script/ETHCallbackFunctionCache.cpp \
+	$(ENGINE_PATH)/Script/ETHEntityCallbackDispatcher.cpp \
 	$(ENGINE_PATH)/Script/ETHEntityDestructorScript.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.Audio.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.Drawing.cpp \
@@ -99,6 +108,10 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Physics/ETHContactListener.cpp \
 	$(ENGINE_PATH)/Physics/ETHCollisionBox.cpp \
 	$(ENGINE_PATH)/Physics/ETHCompoundShape.cpp \
+	$(ENGINE_PATH)/Physics/ETHShapeCache.cpp \
+	$(ENGINE_PATH)/Physics/ETHPhysicsTaskExecutor.cpp \
+	$(ENGINE_PATH)/Physics/ETHPhysicsStepGuard.cpp \
+	$(ENGINE_PATH)/Physics/ETHPhysicsSnapshot.cpp \
 	$(ENGINE_PATH)/Physics/ETHPolygon.cpp \
 	$(ENGINE_PATH)/Physics/ETHDestructionListener.cpp \
 	$(ENGINE_PATH)/Physics/ETHJoint.cpp \
@@ -955,6 +955,95 @@ public:
 	}
 };
 
+/**
+ * Light-weight xorshift128 random number generator. Unlike Randomizer, each
+ * instance keeps its own state, so it can be owned by a single emitter, worker
+ * thread or SIMD kernel and produces the same sequence for the same seed.
+ * Values are computed in single precision only.
+ */
+class RandomStream
+{
+	unsigned int m_x, m_y, m_z, m_w;
+
+public:
+	RandomStream(const unsigned int seed = 0)
+	{
+		Seed(seed);
+	}
+
+	inline void Seed(const unsigned int seed)
+	{
+		// scramble the seed with splitmix-like steps so that close seeds
+		// won't produce correlated streams. The state can never be all zeros
+		unsigned int s = seed;
+		unsigned int* state[4] = { &m_x, &m_y, &m_z, &m_w };
+		for (int t = 0; t < 4; t++)
+		{
+			s += 0x9E3779B9u;
+			unsigned int z = s;
+			z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+			z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+			*state[t] = (z ^ (z >> 16)) | ((t == 0) ? 1u : 0u);
+		}
+	}
+
+	inline unsigned int UInt()
+	{
+		const unsigned int t = m_x ^ (m_x << 11);
+		m_x = m_y; m_y = m_z; m_z = m_w;
+		m_w = m_w ^ (m_w >> 19) ^ (t ^ (t >> 8));
+		return m_w;
+	}
+
+	/// Returns a value in the [0, 1) range
+	inline float Float()
+	{
+		return static_cast<float>(UInt() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	inline float Float(const float maxValue)
+	{
+		return Float() * maxValue;
+	}
+
+	inline float Float(const float minValue, const float maxValue)
+	{
+		return minValue + (Float() * (maxValue - minValue));
+	}
+
+	/// Returns a value in the [0, maxValue] range, just like Randomizer::Int
+	inline int Int(const int maxValue)
+	{
+		return Min(static_cast<int>(Float() * static_cast<float>(maxValue + 1)), maxValue);
+	}
+
+	inline int Int(const int minValue, const int maxValue)
+	{
+		const int min = Min(minValue, maxValue);
+		const int max = Max(minValue, maxValue);
+		return Int(max - min) + min;
+	}
+
+	/// Fills out[0..count-1] with values in the [minValue, maxValue) range
+	inline void Fill(float* out, const unsigned int count, const float minValue, const float maxValue)
+	{
+		const float range = maxValue - minValue;
+		for (unsigned int t = 0; t < count; t++)
+		{
+			out[t] = minValue + (static_cast<float>(UInt() >> 8) * (1.0f / 16777216.0f) * range);
+		}
+	}
+
+	/// Fills out[0..count-1] with raw 32-bit values
+	inline void Fill(unsigned int* out, const unsigned int count)
+	{
+		for (unsigned int t = 0; t < count; t++)
+		{
+			out[t] = UInt();
+		}
+	}
+};
+
 typedef Vector4 Plane;
 inline Plane ComputePlane(const Vector3& pos, const Vector3& normal)
 {
@@ -40,13 +40,22 @@
 using namespace gs2d;
 using namespace gs2d::math;
 
-void ProcParams(int argc, wchar_t* argv[], bool& compileAndRun, bool& testing, bool& wait)
+void ProcParams(int argc, wchar_t* argv[], bool& compileAndRun, bool& testing, bool& wait, std::wstring& profileFile)
 {
 	compileAndRun = true;
 	testing = false;
 	wait = true;
+	profileFile = L"";
 	for (int t=0; t<argc; t++)
 	{
+		if (wcscmp(argv[t], L"-profile") == 0)
+		{
+			// the output file name is optional
+			if (t + 1 < argc && argv[t + 1][0] != L'-')
+				profileFile = argv[++t];
+			else
+				profileFile = L"script.profile.txt";
+		}
 		if (wcscmp(argv[t], L"-nowait") == 0)
 		{
 			wait = false;
@@ -72,7 +81,8 @@ int wmain(int argc, wchar_t* argv[])
 	#endif
 
 	bool compileAndRun, testing, wait;
-	ProcParams(argc, argv, compileAndRun, testing, wait);
+	std::wstring profileFile;
+	ProcParams(argc, argv, compileAndRun, testing, wait, profileFile);
 	// compileAndRun = false;
 
 	const ETH_WINDOW_ENML_FILE app(resourcePath + ETH_APP_PROPERTIES_FILE, Platform::FileManagerPtr(new Platform::StdFileManager));
@@ -82,6 +92,8 @@ int wmain(int argc, wchar_t* argv[])
 	{
 		ETHEnginePtr application = ETHEnginePtr(new ETHEngine(testing, compileAndRun, resourcePath));
 		application->SetHighEndDevice(true); // the PC will always be considered as a high-end device
+		if (!profileFile.empty())
+			application->SetScriptProfileFile(profileFile);
 		VideoPtr video;
 		if ((video = CreateVideo(app.width, app.height, app.title.c_str(), app.windowed, app.vsync, bitmapFontPath.c_str(), GSPF_UNKNOWN, false)))
 		{